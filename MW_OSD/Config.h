@@ -117,6 +117,7 @@
 
 //#define CANVAS_SUPPORT            // Enable CANVAS mode support for post betaflight 3.1.0 CMS
 //#define INVERTED_CHAR_SUPPORT     // Enable inverted char support
+//#define EXTENDED_CHAR_ATTR        // Enable blink and local background char attributes in addition to inverted. Uses 120 bytes RAM
 
 
 /********************       DATE & TIME settings      *********************/
@@ -131,6 +132,7 @@
 //Select ONLY if you are sure your OSD is connected to a telemetry feed such as MAVLINK/LTM:
 //#define RESETHOMEARMED            // Uncomment this ONLY if armed information is sent within telemetry feed AND you do not want to reset home position when re-arming. DO NOT DISARM IN FLIGHT. Enabled in APM/PX4
 //#define FORCE_MSP                 // Uncomment to enable use of MSP as well as telemetry. Uses more memory
+//#define PROTOCOL_AUTODETECT       // Uncomment to choose at runtime between MSP and the one telemetry protocol selected here (MAVLINK or LTM) and only decode and poll that one. KISS, NAZA and GPS (UBX, NMEA, MTK) still need their own build. Enables FORCE_MSP
 //#define PROTOCOL_LTM              // To use LTM protocol instead of MSP
 
 
@@ -187,6 +189,9 @@
 //#define BAUDRATE 38400
 //#define BAUDRATE 19200
 //#define BAUDRATE 9600
+//#define BAUD_AUTODETECT           // Find the serial rate from valid MSP, MAVLink or LTM frames and save it in EEPROM. BAUDRATE is tried first until a rate is saved
+//#define SERIAL_TX_QUEUE           // Requests and GUI replies wait for room in the serial transmit buffer instead of stalling the loop. Adds a transmit buffer to MSP_RX_ISR and SERIAL_RX_RING
+//#define SERIAL_RX_RING            // Own serial driver with a receive buffer sized for the protocol instead of 64 bytes. Counts bytes lost and framing errors. See DEBUGDPOSMSPRX
 
 
 /******************** Mavlink settings *********************/
@@ -200,6 +205,7 @@
 //#define MAV_RESET_HOME            // Resets home position when not armed. When enabled, note that RX glitch etc. could potentially reset home position.
 //#define MAV_WIND_DIR_REVERSE      // SHow direction in which wind is coming from. Same as otehr OSD. Default is to show direction of wind flow.
 //#define MAV_VBAT2                 // Use VBAT2 from mavlink instead of direct connect
+//#define MAV_ADAPTIVE_RATE         // Adjust requested stream rates to the measured link use. Raises attitude toward the video frame rate when there is spare capacity, slows other streams when the link is near full
 
 /******************** Mavlink distance sensor settings *********************/
 // Choose ONLY ONE SENSOR option AND enable MAVSENSORACTIVE
@@ -216,6 +222,10 @@
 #define MSP_USE_BARO                // Disable if not used to increase serial speed update for MSP based FC: Baro IC data such as  altitude
 #define MSP_USE_GPS                 // Disable if not used to increase serial speed update for MSP based FC: GPS data such as speed , distance
 #define MSP_USE_ANALOG              // Disable if not used to increase serial speed update for MSP based FC: Voltage, Amperage or RSSI from the FC
+//#define MSP_RX_ISR                // Assemble MSP frames in the serial interrupt so none are lost while screen or sensors are busy. MSP only. Uses 3 frames of SERIALBUFFERSIZE, 310 bytes RAM by default
+//#define MSP_SCHEDULER             // Poll each MSP request at its own rate and priority. See mspSchedTable. Replaces the MSP_SPEED options
+//#define MSP_PIPELINE              // Keep several MSP requests outstanding and send the next as soon as a reply arrives. Enables MSP_SCHEDULER
+//#define CRC8_NIBBLE_TABLE         // MSPv2 and DELTA_SCREEN_UPDATE CRC from a 16 byte table instead of 256 bytes. Saves 240 bytes flash, a little slower
 
 
 /********************       CALLSIGN settings      *********************/
@@ -247,6 +257,12 @@
 #define MAXSTALLDETECT              // Enable to attempt to detect MAX chip stall from bad power. Attempts to restart.
 #define AUTOCAM                     // Disable if no screen display. Enables autodetect Camera type PAL/NTSC. Overrides GUI/OSD settings.
 //#define USE_VSYNC                 // Removes sparklies as updates screen during blanking time period. Only of benefit for MAX7456 IC 
+//#define DELTA_SCREEN_UPDATE       // Only sends screen cells that have changed to the MAX chip. Reduces SPI time and frees loop time. Uses 120 bytes RAM
+//#define MAX7456_LOOP_DRAW         // Sends screen updates to the MAX chip a few bytes per loop pass so serial and sensors keep running during the update
+//#define RENDER_LIST               // Builds the list of visible widgets when the layout changes instead of testing every widget each frame. Reduces render time
+//#define WIDGET_SUBSCRIBE          // Request only the FC telemetry needed by visible screen items, alarms and the flight summary. Requests are updated when the layout changes
+//#define FONT_SYNC                 // Font uploads only rewrite characters that differ from the MAX chip NVM. Faster uploads and less NVM wear
+//#define FONT_PIPELINE             // GUI font upload receives the next characters while NVM is written. Shows upload time when complete. Uses 120 bytes RAM. Needs a GUI that starts the upload with OSD_FONT_PIPELINE. Other GUIs use the normal upload
 #define DECIMAL '.'                 // Decimal point character, change to what suits you best (.) (,)
 //#define ALT_CENTER                // Enable alternative center crosshair
 //#define FORCECROSSHAIR            // Forces a crosshair even if no AHI / horizon used
@@ -18,8 +18,21 @@
 #define DEBUGDPOSPACKET 280  // display serial packet rate rate value at position X
 #define DEBUGDPOSMEMORY 310  // display free heap/stack memory at position X. Requires MEMCHECK and not valid in latest Arduino versions
 #define DEBUGDPOSRX 220      // display serial data rate at position X
+//#define DEBUGDPOSSPI 340     // display SPI bytes saved on last screen update at position X. Requires DELTA_SCREEN_UPDATE
+//#define DEBUGDPOSPUSH 370    // display time in us of last screen update at position X
+//#define DEBUGDPOSOVERLAP 349 // display loops per second run during background screen updates at position X. Requires MAX7456_LOOP_DRAW
+//#define DEBUGDPOSFIELD 381   // display SPI bytes sent in last VSYNC field and fields used by last screen update, 9 or more shown as 9, at position X. Requires USE_VSYNC
+//#define DEBUGDPOSMSPRX 330   // display MSP frames lost with frame queue full and frames dropped at position X. Requires MSP_RX_ISR. With SERIAL_RX_RING bytes lost and framing errors
+//#define DEBUGDPOSDECODE 300  // display longest MSP descriptor table decode time in us over the last second at position X
+//#define DEBUGDPOSMSPSCHED 330 // display requests per second, 99 max, sent for each mspSchedTable entry at position X. Requires MSP_SCHEDULER. Replaces rows 11-12 items
+//#define DEBUGDPOSMSPRTT 360  // display average MSP round trip time in 0.1ms, replies and timeouts per second, 999 max, at position X. Requires MSP_PIPELINE. Replaces rows 11-12 items
+//#define DEBUGDPOSPROTOCOL 25 // display protocol locked by PROTOCOL_AUTODETECT at position X
+//#define DEBUGDPOSBAUD 257    // display serial rate selected by BAUD_AUTODETECT, ? while searching, at position X
+//#define DEBUGDPOSTX 231      // display serial transmit buffer high water mark, 99 max, and writes deferred per second, 9999 max, at position X. Requires SERIAL_TX_QUEUE
 //#define DEBUGDPOSMSPID 33  // display MSP ID received
 //#define DEBUGDPOSMAV       // display d0-3 as mav packet rates for VFR_HUD, Attitude, GPS raw, RC raw
+//#define DEBUGDPOSMAVSKIP 330 // display MAVLink bytes per second skipped without decoding at position X. Replaces rows 11-12 items
+//#define DEBUGDPOSMAVRATE 338 // display requested and received attitude rate, link use % and stream backoff at position X. Requires MAV_ADAPTIVE_RATE. Replaces rows 11-12 items
 
 //#define DEBUG 4                   // Enable/disable option to display OSD debug values. Define which OSD switch position to show debug on screen display 0 (default), 1 or 2. 4 for always on
 
@@ -1231,18 +1244,103 @@ enum {
 #define FORECSENSORACC
 #endif
 
+#ifdef PROTOCOL_AUTODETECT
+  #if (defined PROTOCOL_MAVLINK || defined PROTOCOL_LTM) && !defined PROTOCOL_KISS && !defined PROTOCOL_SKYTRACK
+    #define FORCE_MSP                 // MSP and the telemetry protocol both compiled in
+  #else
+    #undef PROTOCOL_AUTODETECT        // Single decoder. Only MSP against MAVLink or LTM is detected
+  #endif
+#endif
+
 #ifdef FORCE_MSP
 #define PROTOCOL_MSP
 #endif
 
+#if defined BAUD_AUTODETECT && (defined GPSOSD || defined NAZA || defined I2C_UB_SUPPORT)
+  #undef BAUD_AUTODETECT            // Port set up for the GPS or shared with I2C
+#endif
+
+#ifdef BAUD_AUTODETECT
+  #define BAUD_LOST_TIME         5  // s without valid frames before checking the rate again
+  #define BAUD_EEPROM        E2END  // Detected rate. Last EEPROM byte, outside the GUI settings
+  #define BAUD_EEPROM_MAGIC   0xB0  // High nibble marks a saved rate, low nibble is the baudRates index
+#endif
+
+#if defined PROTOCOL_AUTODETECT || defined BAUD_AUTODETECT
+  #define SERIAL_FRAME_HOOK
+#endif
+
+#define PROTOCOL_ID_NONE     0
+#define PROTOCOL_ID_MSP      1
+#define PROTOCOL_ID_MAVLINK  2
+#define PROTOCOL_ID_LTM      3
+
+#ifdef PROTOCOL_AUTODETECT
+  #define PROTOCOL_LOCK_FRAMES    3   // Valid frames in a row needed to lock onto a protocol
+  #define PROTOCOL_LOCK_TIMEOUT  3000 // ms without frames before searching again
+  #define PROTOCOL_ACTIVE(id) (protocolLocked == PROTOCOL_ID_NONE || protocolLocked == (id))
+#else
+  #define PROTOCOL_ACTIVE(id) 1
+#endif
+
 #ifndef PROTOCOL_MAVLINK
  #ifdef MAV_STATUS
    #undef MAV_STATUS
  #endif  
 #endif
 
+#if defined MAV_ADAPTIVE_RATE && (!defined PROTOCOL_MAVLINK || defined BUDDYFLIGHT)
+  #undef MAV_ADAPTIVE_RATE          // Stream rates are only requested from a MAVLink FC
+#endif
+
+#ifdef MAV_ADAPTIVE_RATE
+  #define MAV_RATE_PERIOD        4  // s between rate changes. Gives the FC time to apply the last requests
+  #define MAV_LINK_HIGH         85  // % of the serial rate used above which rates are lowered
+  #define MAV_LINK_LOW          60  // % of the serial rate used below which rates are raised
+  #define MAV_ATTITUDE_STEP      5  // Hz change to the attitude rate
+  #define MAV_ATTITUDE_MAX (flags.signaltype ? 25 : 30) // Hz. Video frame rate
+  #define MAV_BACKOFF_MAX        2  // Other stream rates are halved up to this many times
+#endif
+
 /********************  MSP speed enhancements rule definitions  *********************/
 
+#ifdef MSP_PIPELINE
+  #define MSP_SCHEDULER
+#endif
+
+#if defined MSP_SCHEDULER && (!defined PROTOCOL_MSP || defined KISS || defined SKYTRACK)
+  #undef MSP_SCHEDULER
+  #undef MSP_PIPELINE
+#endif
+
+#ifdef MSP_SCHEDULER
+  #undef  MSP_SPEED_MED             // Attitude rate set in mspSchedTable
+  #undef  MSP_SPEED_HIGH
+  #define MSP_SPEED_LOW
+  #define MSP_SCHED_TICK        10  // ms between requests. Limits requests to 100 per second
+#endif
+
+#ifdef MSP_PIPELINE
+  #define MSP_PIPELINE_DEPTH     2  // Requests awaiting a reply. Replies must fit the serial RX buffer
+  #define MSP_PIPELINE_TIMEOUT 100  // ms before a reply is treated as lost
+#endif
+
+/********************  Debug screen rule definitions  *********************/
+
+// Protocol debug items share rows 11-12 of the NTSC screen
+#if defined DEBUGDPOSMAVSKIP || defined DEBUGDPOSMAVRATE
+  #undef DEBUGDPOSMSPSCHED
+  #undef DEBUGDPOSMSPRTT
+#endif
+
+#if defined DEBUGDPOSMSPSCHED || defined DEBUGDPOSMSPRTT || defined DEBUGDPOSMAVSKIP || defined DEBUGDPOSMAVRATE
+  #undef DEBUGDPOSMSPRX
+  #undef DEBUGDPOSSPI
+  #undef DEBUGDPOSOVERLAP
+  #undef DEBUGDPOSPUSH
+  #undef DEBUGDPOSFIELD
+#endif
+
 #if defined MSP_SPEED_HIGH
   #define hi_speed_cycle  10  // updates everything approx 6.3 times per second, updates attitude 30 times per second
 #elif defined MSP_SPEED_MED
@@ -1251,6 +1349,91 @@ enum {
   #define hi_speed_cycle  30  // updates everything approx 3 times per second
 #endif
 
+#if defined MSP_RX_ISR && (!defined PROTOCOL_MSP || defined FORCE_MSP || defined I2C_UB_SUPPORT || defined PROTOCOL_SKYTRACK)
+  #undef MSP_RX_ISR                 // Serial shared with other protocols
+#endif
+
+#ifdef MSP_RX_ISR
+  #define MSP_RX_FRAMES         3   // Complete frames queued for serialMSPreceive
+  #if defined NAZA                  // Largest payload. Same as SERIALBUFFERSIZE so no reply the byte parser takes is dropped
+    #define MSP_RX_FRAMESIZE  125
+  #elif defined SUBMERSIBLE || defined iNAV
+    #define MSP_RX_FRAMESIZE   65
+  #else
+    #define MSP_RX_FRAMESIZE  100
+  #endif
+  #undef SERIAL_RX_RING             // Frames queued instead of bytes
+#endif
+
+#if defined SERIAL_RX_RING && defined I2C_UB_SUPPORT
+  #undef SERIAL_RX_RING             // WireUB starts the Arduino Serial port
+#endif
+
+#ifdef SERIAL_RX_RING
+  #ifndef SERIAL_RX_BUFFER          // Power of 2, max 256
+    #if defined PROTOCOL_MAVLINK
+      #define SERIAL_RX_BUFFER 256  // ATTITUDE, VFR_HUD, GPS_RAW_INT and SYS_STATUS burst is 141 bytes
+    #elif defined NAZA || defined KISS
+      #define SERIAL_RX_BUFFER 128  // Frames up to 125 bytes
+    #else
+      #define SERIAL_RX_BUFFER 128
+    #endif
+  #endif
+#endif
+
+#if defined MSP_RX_ISR || defined SERIAL_RX_RING
+  #define OSD_SERIAL                // OSDSerial replaces the Arduino Serial port
+#endif
+
+#ifdef SERIAL_TX_QUEUE
+  #ifdef OSD_SERIAL
+    #define SERIAL_TX_BUFFER   64   // OSDSerial transmit buffer. Power of 2
+    #define SERIAL_TX_ROOM     (SERIAL_TX_BUFFER - 1)
+  #else
+    #define SERIAL_TX_ROOM     (SERIAL_TX_BUFFER_SIZE - 1) // Arduino Serial transmit buffer
+  #endif
+#else
+  #define serialTxReady(len)   1
+#endif
+#ifdef MSPV2
+  #define MSP_REQUEST_LEN       9   // Empty MSPv2 request
+#else
+  #define MSP_REQUEST_LEN       6
+#endif
+
+
+/********************  MAX7456 screen update rule definitions  *********************/
+
+#ifdef EXTENDED_CHAR_ATTR
+  #define INVERTED_CHAR_SUPPORT
+#endif
+
+#ifdef INVERTED_CHAR_SUPPORT
+  #define MAX7456_ATTR_INV   0x08   // Char attributes. Match the MAX7456 DMM attribute bits
+  #define MAX7456_ATTR_BLK   0x10
+  #define MAX7456_ATTR_LBC   0x20
+#endif
+
+#ifdef DELTA_SCREEN_UPDATE
+  #define DELTA_SCREEN_BLOCK    4   // Screen cells covered by each shadow signature byte
+  #define DELTA_SCREEN_REFRESH 32   // Frames between full screen updates. Recovers from signature collisions and MAX glitches
+#endif
+
+#ifdef FONT_PIPELINE
+  #define FONT_QUEUE            2   // Characters buffered while NVM is written. GUI window
+  #define FONT_MESSAGE_TIME     5   // Seconds upload time is displayed
+#endif
+
+#ifdef USE_VSYNC
+  #define MAX7456_LOOP_DRAW         // VSYNC aligned updates are sent from loop()
+  #define VSYNC_WINDOW       1200   // us after VSYNC in which the frame is sent. Vertical blanking, NTSC 1270us, PAL 1600us
+  #define VSYNC_TIMEOUT        40   // ms without VSYNC before sending regardless. e.g. no camera
+#endif
+
+#ifdef MAX7456_LOOP_DRAW
+  #define MAX7456_DRAW_CHUNK   16   // SPI bytes sent per loop pass. About 40us at fosc/2
+#endif
+
 
 /********************  RX channel rule definitions  *********************/
 
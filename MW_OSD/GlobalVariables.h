@@ -239,6 +239,14 @@ uint16_t MAX_screen_size;
 char screen[480];          // Main screen ram for MAX7456
 #ifdef INVERTED_CHAR_SUPPORT
 uint8_t screenAttr[480/8]; // Attribute (INV) bits for each char in screen[]
+#ifdef EXTENDED_CHAR_ATTR
+uint8_t screenBlink[480/8]; // Attribute (BLK) bits for each char in screen[]
+uint8_t screenLBC[480/8];   // Attribute (LBC) bits for each char in screen[]
+#endif
+#endif
+#ifdef DELTA_SCREEN_UPDATE
+uint8_t screenShadow[480/DELTA_SCREEN_BLOCK]; // Signature of each block of chars already held by the MAX7456
+uint8_t screenRefresh = 0;                    // Frames until next full screen update. 0 = update all
 #endif
 char screenBuffer[20]; 
 uint32_t modeMSPRequests;
@@ -280,6 +288,23 @@ struct  __timer {
   uint16_t  loopcount;
   uint16_t  packetcount;
   uint16_t  serialrxrate;
+#if defined DEBUGDPOSOVERLAP && defined MAX7456_LOOP_DRAW
+  uint16_t  overlapcount;
+#endif
+#ifdef DEBUGDPOSDECODE
+  uint16_t  decodemax;
+#endif
+#if defined DEBUGDPOSTX && defined SERIAL_TX_QUEUE
+  uint16_t  txdeferred;
+#endif
+#if defined DEBUGDPOSMSPRTT && defined MSP_PIPELINE
+  uint16_t  mspreplies;
+  uint16_t  msptimeouts;
+  uint32_t  msprttsum;
+#endif
+#if defined DEBUGDPOSMAVSKIP && defined PROTOCOL_MAVLINK
+  uint16_t  mavskipped;
+#endif
 #ifdef DEBUGDPOSMAV 
   uint16_t  d0rate;
   uint16_t  d1rate;  
@@ -292,6 +317,9 @@ struct  __timer {
   uint32_t GPSOSDstate;
   uint8_t  disarmed;                             
   uint8_t  fcMessage;                        // Duration of the FC message (in seconds)
+#ifdef FONT_PIPELINE
+  uint8_t  fontMessage;                      // Duration of the font upload time message (in seconds)
+#endif
   uint8_t  armedstatus;   
   uint8_t  adsbttl;
 }
@@ -461,6 +489,21 @@ uint8_t fontData[54];
 uint8_t nextCharToRequest;
 uint8_t lastCharToRequest;
 uint8_t retransmitQueue;
+#ifdef FONT_PIPELINE
+struct __fontqueue {
+  uint8_t index;
+  uint8_t data[54];
+}
+fontQueue[FONT_QUEUE];
+uint8_t fontQueueHead;
+uint8_t fontQueueCount;
+uint8_t fontPipeline;                         // Upload started with OSD_FONT_PIPELINE
+uint8_t fontNVMActive;                        // NVM write in progress
+uint8_t fontLastChar;                         // Last character handed to NVM. Acknowledged sequence number
+uint8_t fontEnd;
+uint32_t fontUploadStart;
+uint16_t fontUploadTime;                      // Tenths of a second
+#endif
 
 uint16_t eeaddress = 0;
 uint8_t eedata = 0;
@@ -469,6 +512,57 @@ uint8_t settingsMode=0;
 uint16_t framerate = 0;
 uint16_t packetrate = 0;
 uint16_t serialrxrate = 0;
+#if defined DEBUGDPOSSPI && defined DELTA_SCREEN_UPDATE
+uint16_t spisaved = 0;
+#endif
+#ifdef DEBUGDPOSPUSH
+uint16_t pushtime = 0;
+#endif
+#if defined DEBUGDPOSOVERLAP && defined MAX7456_LOOP_DRAW
+uint16_t overlaprate = 0;
+#endif
+#ifdef DEBUGDPOSDECODE
+uint16_t decodetime = 0;
+#endif
+#ifdef PROTOCOL_AUTODETECT
+uint8_t  protocolLocked = PROTOCOL_ID_NONE;
+uint8_t  protocolCandidate = PROTOCOL_ID_NONE;
+uint8_t  protocolFrames = 0;       // Valid frames in a row from protocolCandidate
+uint16_t protocolLastFrame = 0;    // ms
+#endif
+#ifdef BAUD_AUTODETECT
+const uint32_t baudRates[] PROGMEM = {115200, 57600, 38400, 19200, 9600};
+#define BAUD_RATES (sizeof(baudRates) / sizeof(baudRates[0]))
+enum { BAUD_VERIFY, BAUD_SCAN, BAUD_LOCKED };
+uint8_t  baudState;
+uint8_t  baudIndex;                // Current entry in baudRates
+uint8_t  baudFrames;               // Valid frames this second
+uint8_t  baudBest;
+uint8_t  baudBestFrames;
+uint8_t  baudIdle;                 // Seconds without frames while locked
+#endif
+#if defined DEBUGDPOSMAVSKIP && defined PROTOCOL_MAVLINK
+uint16_t mavskiprate = 0;
+#endif
+#ifdef MAV_ADAPTIVE_RATE
+uint8_t  mavlinkload = 0;         // % of the serial rate received last second
+uint8_t  mavattituderate = 0;     // ATTITUDE messages received last second
+#endif
+#ifdef SERIAL_TX_QUEUE
+uint8_t serialTxHighWater = 0;     // Most bytes waiting in the transmit buffer
+#ifdef DEBUGDPOSTX
+uint16_t txdeferrate = 0;
+#endif
+#endif
+#if defined DEBUGDPOSMSPRTT && defined MSP_PIPELINE
+uint16_t msprtt = 0;
+uint16_t mspreplyrate = 0;
+uint16_t msptimeoutrate = 0;
+#endif
+#if defined DEBUGDPOSFIELD && defined USE_VSYNC
+uint16_t fieldbytes = 0;
+uint8_t framefields = 0;
+#endif
 
 // Mode bits
 struct __mode {
@@ -796,6 +890,71 @@ enum Positions {
 
 uint16_t screenPosition[POSITIONS_SETTINGS];
 
+#ifdef WIDGET_SUBSCRIBE
+#define TELEMETRY_GPS      (1 << 0)
+#define TELEMETRY_BARO     (1 << 1)
+#define TELEMETRY_ATTITUDE (1 << 2)
+#define TELEMETRY_ANALOG   (1 << 3)
+#define TELEMETRY_AIRSPEED (1 << 4)
+#define TELEMETRY_WIND     (1 << 5)
+
+// FC telemetry each screen item needs
+PROGMEM const uint8_t positionTelemetry[POSITIONS_SETTINGS] = {
+  TELEMETRY_GPS,                            // GPS_numSatPosition
+  TELEMETRY_GPS | TELEMETRY_ATTITUDE,       // GPS_directionToHomePosition
+  TELEMETRY_GPS,                            // GPS_distanceToHomePosition
+  TELEMETRY_GPS,                            // GPS_speedPosition
+  TELEMETRY_GPS,                            // GPS_angleToHomePosition
+  TELEMETRY_GPS,                            // MwGPSAltPosition
+  0,                                        // sensorPosition
+  TELEMETRY_ATTITUDE,                       // MwHeadingPosition
+  TELEMETRY_ATTITUDE,                       // MwHeadingGraphPosition
+  TELEMETRY_BARO,                           // MwAltitudePosition
+  TELEMETRY_BARO,                           // MwVarioPosition
+  0,                                        // CurrentThrottlePosition
+  0,                                        // timer2Position
+  0,                                        // timer1Position
+  0,                                        // motorArmedPosition
+  TELEMETRY_ATTITUDE,                       // pitchAnglePosition
+  TELEMETRY_ATTITUDE,                       // rollAnglePosition
+  TELEMETRY_GPS,                            // MwGPSLatPositionTop
+  TELEMETRY_GPS,                            // MwGPSLonPositionTop
+  TELEMETRY_ANALOG,                         // rssiPosition
+  0,                                        // temperaturePosition
+  TELEMETRY_ANALOG,                         // voltagePosition
+  0,                                        // vidvoltagePosition
+  TELEMETRY_ANALOG,                         // amperagePosition
+  TELEMETRY_ANALOG,                         // pMeterSumPosition
+  TELEMETRY_ATTITUDE,                       // horizonPosition
+  TELEMETRY_GPS | TELEMETRY_BARO,           // SideBarPosition
+  0,                                        // SideBarScrollPosition
+  0,                                        // SideBarHeightSPARE
+  0,                                        // SideBarWidthSPARE
+  0,                                        // gimbalPosition
+  TELEMETRY_GPS,                            // GPS_timePosition
+  0,                                        // SportPosition
+  0,                                        // ModePosition
+  TELEMETRY_GPS | TELEMETRY_ATTITUDE,       // MapModePosition
+  TELEMETRY_GPS | TELEMETRY_ATTITUDE,       // MapCenterPosition
+  0,                                        // APstatusPosition
+  TELEMETRY_ANALOG,                         // wattPosition
+  TELEMETRY_GPS | TELEMETRY_BARO,           // glidescopePosition
+  0,                                        // callSignPosition
+  0,                                        // debugPosition
+  TELEMETRY_BARO,                           // climbratevaluePosition
+  TELEMETRY_GPS | TELEMETRY_ANALOG,         // efficiencyPosition
+  TELEMETRY_GPS | TELEMETRY_ANALOG,         // avgefficiencyPosition
+  TELEMETRY_AIRSPEED,                       // AIR_speedPosition
+  TELEMETRY_GPS | TELEMETRY_AIRSPEED,       // MAX_speedPosition
+  TELEMETRY_GPS,                            // TotalDistanceposition
+  TELEMETRY_WIND,                           // WIND_speedPosition
+  TELEMETRY_GPS,                            // MaxDistanceposition
+  TELEMETRY_GPS,                            // DOPposition
+};
+
+uint8_t telemetryUsed;                      // TELEMETRY_ bits needed by the current layout
+#endif // WIDGET_SUBSCRIBE
+
 PROGMEM const uint16_t SCREENLAYOUT_DEFAULT[POSITIONS_SETTINGS] = {
 (LINE02+2)|DISPLAY_ALWAYS|DISPLAY_DEV,    // GPS_numSatPosition
 (LINE02+20)|DISPLAY_ALWAYS|DISPLAY_DEV,   // GPS_directionToHomePosition
@@ -1162,12 +1321,19 @@ int16_t rssiMIN=100;
 #define OSD_READ_CMD_EE          9
 #define OSD_INFO                 10
 #define OSD_SENSORS2             11
+#define OSD_FONT_CHECKSUM        12
+#define OSD_FONT_ACK             13
+#define OSD_FONT_PIPELINE        14
+#define OSD_FONT_NAK             15
 
 // End private MSP for use with the GUI
 
 
 const char blank_text[]     PROGMEM = "";
 const char nodata_text[]    PROGMEM = "NO DATA";
+#ifdef FONT_PIPELINE
+const char fontupload_text[] PROGMEM = "FONT UPLOAD";
+#endif
 const char nogps_text[]     PROGMEM = " NO GPS";
 const char satlow_text[]    PROGMEM = "LOW SATS";
 const char disarmed_text[]  PROGMEM = "DISARMED";
@@ -1657,6 +1823,51 @@ const unsigned char UnitsIcon[10]={
 #define REQ_MSP_KISS_GPS             (1L<<30)
 #define REQ_MSP_KISS_MESSAGE         (1L<<31)
 #endif
+
+#ifdef MSP_SCHEDULER
+struct __mspsched {
+  uint32_t req;
+  uint16_t period;                  // ms
+  uint8_t  priority;
+};
+
+// Target period and priority of each request. When several are due the highest
+// priority is sent first, then the most overdue. req 0 is every other request
+// in modeMSPRequests, sent round robin.
+const struct __mspsched mspSchedTable[] PROGMEM = {
+  {REQ_MSP_ATTITUDE,        1000 / 30, 3},
+  {REQ_MSP_STATUS,          1000 / 10, 2},
+  {REQ_MSP_RAW_GPS,         1000 / 5,  1},
+  {REQ_MSP_COMP_GPS,        1000 / 5,  1},
+  {REQ_MSP_ANALOG,          1000 / 5,  1},
+  {REQ_MSP_ALTITUDE,        1000 / 5,  1},
+  {REQ_MSP_RC,              1000 / 5,  1},
+#ifdef MSPV2
+  {REQ_MSP2_INAV_AIR_SPEED, 1000 / 5,  1},
+#endif
+  {0,                       1000 / 10, 0},
+};
+#define MSP_SCHED_ENTRIES (sizeof(mspSchedTable) / sizeof(mspSchedTable[0]))
+
+#ifndef MSP_PIPELINE
+uint16_t mspSchedTick;
+#endif
+uint16_t mspSchedSent[MSP_SCHED_ENTRIES];
+#ifdef DEBUGDPOSMSPSCHED
+static_assert(MSP_SCHED_ENTRIES <= 9, "DEBUGDPOSMSPSCHED row holds 9 entries");
+uint8_t mspSchedCount[MSP_SCHED_ENTRIES];
+uint8_t mspSchedRate[MSP_SCHED_ENTRIES];  // Requests sent in the last second
+#endif
+#ifdef MSP_PIPELINE
+struct __mspoutstanding {
+  uint16_t cmd;                     // 0 = free
+  uint8_t  entry;                   // mspSchedTable entry that sent it
+  uint32_t sent;                    // us
+}
+mspOutstanding[MSP_PIPELINE_DEPTH];
+#endif
+#endif // MSP_SCHEDULER
+
 // Menu selections
 
 
@@ -2031,6 +2242,13 @@ struct __mw_mav {
   uint16_t serial_checksum;
   uint16_t tx_checksum;
   uint16_t throttle;
+  uint8_t  requests;                // Stream requests still to send
+#ifdef MAV_ADAPTIVE_RATE
+  uint16_t rxbytes;                 // Bytes received this second
+  uint8_t  attitudes;               // ATTITUDE messages received this second
+  uint8_t  attitudeboost;           // Hz requested above MAV_ATTITUDE_RATE
+  uint8_t  backoff;                 // Other stream rates are shifted right by this
+#endif
 }mw_mav;
 
 #endif //ADSB_MAVLINK
@@ -2103,6 +2321,8 @@ struct __mw_mav {
 #define MAVLINK_MSG_ID_COMMAND_LONG_MAGIC 152
 #define MAVLINK_MSG_ID_COMMAND_LONG_LEN 33
 #define MAV_STREAMS 7
+#define MAV_CMD_MAX 12                // PX4 message interval requests
+#define MAV_ATTITUDE_RATE 10          // Hz. Default ATTITUDE request
 #define MAV_DATA_STREAM_RAW_SENSORS 1
 #define MAV_DATA_STREAM_EXTENDED_STATUS 2
 #define MAV_DATA_STREAM_RC_CHANNELS 3
@@ -2111,6 +2331,266 @@ struct __mw_mav {
 #define MAV_DATA_STREAM_EXTRA2 11
 #define MAV_DATA_STREAM_EXTRA3 12
 #define MAV_COMP_ID_OSD 157
+#define MAVLINK_STX_V1 0xFE
+#define MAVLINK_STX_V2 0xFD
+#define MAVLINK_IFLAG_SIGNED 0x01
+#define MAVLINK_SIGNATURE_LEN 13
+
+// Messages decoded by serialMAVCheck. X(id, b) is applied to each
+#ifdef MAV_VBAT2
+  #define MAV_LIST_VBAT2(X, b) X(MAVLINK_MSG_ID_BATTERY2, b)
+#else
+  #define MAV_LIST_VBAT2(X, b)
+#endif
+#ifdef MAVSENSOR132
+  #define MAV_LIST_SENSOR132(X, b) X(MAVLINK_MESSAGE_INFO_DISTANCE_SENSOR, b)
+#else
+  #define MAV_LIST_SENSOR132(X, b)
+#endif
+#ifdef MAVSENSOR173
+  #define MAV_LIST_SENSOR173(X, b) X(MAVLINK_MSG_ID_RANGEFINDER, b)
+#else
+  #define MAV_LIST_SENSOR173(X, b)
+#endif
+#ifdef MAV_ADSB
+  #define MAV_LIST_ADSB(X, b) X(MAVLINK_MSG_ID_ADSB_TRAFFIC_REPORT_MESSAGE, b)
+#else
+  #define MAV_LIST_ADSB(X, b)
+#endif
+#ifdef ADSBDEBUG
+  #define MAV_LIST_ADSBDEBUG(X, b) X(MAVLINK_MSG_ID_ADSB_STATUS, b)
+#else
+  #define MAV_LIST_ADSBDEBUG(X, b)
+#endif
+#ifdef MAV_RTC
+  #define MAV_LIST_RTC(X, b) X(MAVLINK_MSG_ID_SYSTEM_TIME, b)
+#else
+  #define MAV_LIST_RTC(X, b)
+#endif
+#define MAV_MESSAGE_LIST(X, b) \
+  X(MAVLINK_MSG_ID_HEARTBEAT, b) \
+  X(MAVLINK_MSG_ID_VFR_HUD, b) \
+  X(MAVLINK_MSG_ID_ATTITUDE, b) \
+  X(MAVLINK_MSG_ID_GPS_RAW_INT, b) \
+  X(MAVLINK_MSG_ID_RC_CHANNELS_RAW, b) \
+  X(MAVLINK_MSG_ID_RC_CHANNELS, b) \
+  X(MAVLINK_MSG_ID_SYS_STATUS, b) \
+  X(MAVLINK_MSG_ID_WIND, b) \
+  X(MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT, b) \
+  X(MAVLINK_MSG_ID_MISSION_CURRENT, b) \
+  X(MAVLINK_MSG_ID_SCALED_PRESSURE, b) \
+  X(MAVLINK_MSG_ID_SCALED_PRESSURE2, b) \
+  X(MAVLINK_MSG_ID_STATUSTEXT, b) \
+  MAV_LIST_VBAT2(X, b) \
+  MAV_LIST_SENSOR132(X, b) \
+  MAV_LIST_SENSOR173(X, b) \
+  MAV_LIST_ADSB(X, b) \
+  MAV_LIST_ADSBDEBUG(X, b) \
+  MAV_LIST_RTC(X, b)
+
+// CRC_EXTRA and MAVLink 1 payload length
+struct __mavmessage {
+  uint8_t id;
+  uint8_t crcextra;
+  uint8_t len;
+};
+
+#define MAV_ENTRY(id, b) {id, id##_MAGIC, id##_LEN},
+const struct __mavmessage mavMessages[] PROGMEM = {
+  MAV_MESSAGE_LIST(MAV_ENTRY, 0)
+};
+#define MAV_MESSAGES (sizeof(mavMessages) / sizeof(mavMessages[0]))
+
+// Bitmap of decoded message IDs, checked before anything is buffered
+#define MAV_BIT(id, b) | (((id) >> 3) == (b) ? 1 << ((id) & 7) : 0)
+#define MAV_HANDLED(b) (0 MAV_MESSAGE_LIST(MAV_BIT, b))
+const uint8_t mavHandled[32] PROGMEM = {
+  MAV_HANDLED(0),  MAV_HANDLED(1),  MAV_HANDLED(2),  MAV_HANDLED(3),
+  MAV_HANDLED(4),  MAV_HANDLED(5),  MAV_HANDLED(6),  MAV_HANDLED(7),
+  MAV_HANDLED(8),  MAV_HANDLED(9),  MAV_HANDLED(10), MAV_HANDLED(11),
+  MAV_HANDLED(12), MAV_HANDLED(13), MAV_HANDLED(14), MAV_HANDLED(15),
+  MAV_HANDLED(16), MAV_HANDLED(17), MAV_HANDLED(18), MAV_HANDLED(19),
+  MAV_HANDLED(20), MAV_HANDLED(21), MAV_HANDLED(22), MAV_HANDLED(23),
+  MAV_HANDLED(24), MAV_HANDLED(25), MAV_HANDLED(26), MAV_HANDLED(27),
+  MAV_HANDLED(28), MAV_HANDLED(29), MAV_HANDLED(30), MAV_HANDLED(31),
+};
+
+// Payloads in wire order. Overlaid on serialBuffer by mavPayload
+struct mav_heartbeat {
+  uint32_t custom_mode;
+  uint8_t  type;
+  uint8_t  autopilot;
+  uint8_t  base_mode;
+  uint8_t  system_status;
+  uint8_t  mavlink_version;
+} __attribute__ ((packed));
+
+struct mav_sys_status {
+  uint32_t sensors_present;
+  uint32_t sensors_enabled;
+  uint32_t sensors_health;
+  uint16_t load;
+  uint16_t voltage_battery;         // mV
+  int16_t  current_battery;         // 10mA
+  uint16_t drop_rate_comm;
+  uint16_t errors_comm;
+  uint16_t errors_count[4];
+  int8_t   battery_remaining;
+} __attribute__ ((packed));
+
+struct mav_system_time {
+  uint64_t time_unix_usec;
+  uint32_t time_boot_ms;
+} __attribute__ ((packed));
+
+struct mav_gps_raw_int {
+  uint64_t time_usec;
+  int32_t  lat;                     // deg * 1E7
+  int32_t  lon;
+  int32_t  alt;                     // mm
+  uint16_t eph;
+  uint16_t epv;
+  uint16_t vel;                     // cm/s
+  uint16_t cog;                     // deg * 100
+  uint8_t  fix_type;
+  uint8_t  satellites_visible;
+} __attribute__ ((packed));
+
+struct mav_scaled_pressure {
+  uint32_t time_boot_ms;
+  float    press_abs;
+  float    press_diff;
+  int16_t  temperature;             // deg * 100
+} __attribute__ ((packed));
+
+struct mav_attitude {
+  uint32_t time_boot_ms;
+  float    roll;                    // rad
+  float    pitch;
+  float    yaw;
+  float    rollspeed;
+  float    pitchspeed;
+  float    yawspeed;
+} __attribute__ ((packed));
+
+struct mav_rc_channels_raw {
+  uint32_t time_boot_ms;
+  uint16_t chan_raw[8];
+  uint8_t  port;
+  uint8_t  rssi;
+} __attribute__ ((packed));
+
+struct mav_mission_current {
+  uint16_t seq;
+} __attribute__ ((packed));
+
+struct mav_nav_controller_output {
+  float    nav_roll;
+  float    nav_pitch;
+  float    alt_error;
+  float    aspd_error;
+  float    xtrack_error;
+  int16_t  nav_bearing;
+  int16_t  target_bearing;
+  uint16_t wp_dist;                 // m
+} __attribute__ ((packed));
+
+struct mav_rc_channels {
+  uint32_t time_boot_ms;
+  uint16_t chan_raw[18];
+  uint8_t  chancount;
+  uint8_t  rssi;
+} __attribute__ ((packed));
+
+struct mav_vfr_hud {
+  float    airspeed;                // m/s
+  float    groundspeed;
+  float    alt;                     // m
+  float    climb;                   // m/s
+  int16_t  heading;                 // deg
+  uint16_t throttle;                // %
+} __attribute__ ((packed));
+
+struct mav_distance_sensor {
+  uint32_t time_boot_ms;
+  uint16_t min_distance;            // cm
+  uint16_t max_distance;
+  uint16_t current_distance;
+  uint8_t  type;
+  uint8_t  id;
+  uint8_t  orientation;
+  uint8_t  covariance;
+} __attribute__ ((packed));
+
+struct mav_wind {
+  float    direction;               // deg
+  float    speed;                   // m/s
+  float    speed_z;
+} __attribute__ ((packed));
+
+struct mav_rangefinder {
+  float    distance;                // m
+  float    voltage;
+} __attribute__ ((packed));
+
+struct mav_battery2 {
+  uint16_t voltage;                 // mV
+  int16_t  current_battery;
+} __attribute__ ((packed));
+
+struct mav_adsb_vehicle {
+  uint32_t icao_address;
+  int32_t  lat;                     // deg * 1E7
+  int32_t  lon;
+  int32_t  altitude;                // mm
+  uint16_t heading;                 // deg * 100
+  uint16_t hor_velocity;            // cm/s
+  int16_t  ver_velocity;
+  uint16_t flags;
+  uint16_t squawk;
+  uint8_t  altitude_type;
+  char     callsign[9];
+  uint8_t  emitter_type;
+  uint8_t  tslc;
+} __attribute__ ((packed));
+
+union mav_payload {
+  struct mav_heartbeat heartbeat;
+  struct mav_sys_status sys_status;
+  struct mav_system_time system_time;
+  struct mav_gps_raw_int gps_raw_int;
+  struct mav_scaled_pressure scaled_pressure;
+  struct mav_attitude attitude;
+  struct mav_rc_channels_raw rc_channels_raw;
+  struct mav_mission_current mission_current;
+  struct mav_nav_controller_output nav_controller_output;
+  struct mav_rc_channels rc_channels;
+  struct mav_vfr_hud vfr_hud;
+  struct mav_distance_sensor distance_sensor;
+  struct mav_wind wind;
+  struct mav_rangefinder rangefinder;
+  struct mav_battery2 battery2;
+  struct mav_adsb_vehicle adsb_vehicle;
+};
+
+static_assert(sizeof(struct mav_heartbeat) == MAVLINK_MSG_ID_HEARTBEAT_LEN, "HEARTBEAT layout");
+static_assert(sizeof(struct mav_sys_status) == MAVLINK_MSG_ID_SYS_STATUS_LEN, "SYS_STATUS layout");
+static_assert(sizeof(struct mav_system_time) == MAVLINK_MSG_ID_SYSTEM_TIME_LEN, "SYSTEM_TIME layout");
+static_assert(sizeof(struct mav_gps_raw_int) == MAVLINK_MSG_ID_GPS_RAW_INT_LEN, "GPS_RAW_INT layout");
+static_assert(sizeof(struct mav_scaled_pressure) == MAVLINK_MSG_ID_SCALED_PRESSURE_LEN, "SCALED_PRESSURE layout");
+static_assert(sizeof(struct mav_attitude) == MAVLINK_MSG_ID_ATTITUDE_LEN, "ATTITUDE layout");
+static_assert(sizeof(struct mav_rc_channels_raw) == MAVLINK_MSG_ID_RC_CHANNELS_RAW_LEN, "RC_CHANNELS_RAW layout");
+static_assert(sizeof(struct mav_mission_current) == MAVLINK_MSG_ID_MISSION_CURRENT_LEN, "MISSION_CURRENT layout");
+static_assert(sizeof(struct mav_nav_controller_output) == MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT_LEN, "NAV_CONTROLLER_OUTPUT layout");
+static_assert(sizeof(struct mav_rc_channels) == MAVLINK_MSG_ID_RC_CHANNELS_LEN, "RC_CHANNELS layout");
+static_assert(sizeof(struct mav_vfr_hud) == MAVLINK_MSG_ID_VFR_HUD_LEN, "VFR_HUD layout");
+static_assert(sizeof(struct mav_distance_sensor) == MAVLINK_MESSAGE_INFO_DISTANCE_SENSOR_LEN, "DISTANCE_SENSOR layout");
+static_assert(sizeof(struct mav_wind) == MAVLINK_MSG_ID_WIND_LEN, "WIND layout");
+static_assert(sizeof(struct mav_rangefinder) == MAVLINK_MSG_ID_RANGEFINDER_LEN, "RANGEFINDER layout");
+static_assert(sizeof(struct mav_battery2) == MAVLINK_MSG_ID_BATTERY2_LEN, "BATTERY2 layout");
+static_assert(sizeof(struct mav_adsb_vehicle) == MAVLINK_MSG_ID_ADSB_TRAFFIC_REPORT_MESSAGE_LEN, "ADSB_VEHICLE layout");
+
+#define mavPayload (*(union mav_payload *)serialBuffer)
 
 #define  LAT  0
 #define  LON  1
@@ -2617,3 +3097,9 @@ const PROGMEM char * const NAZA_mode_index[] =
 #endif
 
 static uint8_t serialBuffer[SERIALBUFFERSIZE]; // this hold the imcoming string from serial O string
+#ifdef MSP_RX_ISR
+static_assert(MSP_RX_FRAMESIZE == SERIALBUFFERSIZE, "MSP_RX_FRAMESIZE must match SERIALBUFFERSIZE");
+#endif
+#ifdef PROTOCOL_MAVLINK
+static_assert(sizeof(union mav_payload) <= SERIALBUFFERSIZE, "serialBuffer too small for MAVLink payloads");
+#endif
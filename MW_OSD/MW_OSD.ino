@@ -119,6 +119,8 @@ uint16_t UntouchedStack(void)
 #include "symbols.h"
 #include "GlobalVariables.h"
 #include "math.h"
+#include "crc8.h"
+#include "fixed.h"
 
 #if defined LOADFONT_LARGE
 #include "fontL.h"
@@ -130,6 +132,9 @@ uint16_t UntouchedStack(void)
 #ifdef I2C_UB_SUPPORT
 #include "WireUB.h"
 #endif
+#ifdef OSD_SERIAL
+#include "OSDSerial.h"
+#endif
 #ifdef I2C_SUPPORT
 #include <Wire.h>
 #endif
@@ -163,11 +168,10 @@ void setup()
   WDTCSR =  (0 << WDE) | (0 << WDIE);
 #endif
 
-  Serial.begin(BAUDRATE);
-#ifndef PROTOCOL_MAVLINK //use double speed asynch mode (multiwii compatible)
-  uint8_t h = ((F_CPU  / 4 / (BAUDRATE) - 1) / 2) >> 8;
-  uint8_t l = ((F_CPU  / 4 / (BAUDRATE) - 1) / 2);
-  UCSR0A  |= (1 << U2X0); UBRR0H = h; UBRR0L = l;
+#ifdef BAUD_AUTODETECT
+  baudInit();
+#else
+  serialBegin(BAUDRATE);
 #endif
 
 #ifdef I2C_UB_SUPPORT
@@ -321,6 +325,13 @@ void loop()
 
   alarms.active = 0;
   timer.loopcount++;
+#ifdef MAX7456_LOOP_DRAW
+#ifdef DEBUGDPOSOVERLAP
+  if (!MAX7456_FrameDone())
+    timer.overlapcount++;
+#endif
+  MAX7456_DrawNext();
+#endif
   if (flags.reset) {
     resetFunc();
   }
@@ -392,7 +403,7 @@ void loop()
 #endif
     {
 #ifdef PROTOCOL_MSP
-      if (timer.GUI_active == 0) {
+      if (timer.GUI_active == 0 && PROTOCOL_ACTIVE(PROTOCOL_ID_MSP) && serialTxReady(6)) {
         mspWriteRequest(MSP_ATTITUDE, 0);
       }
 #endif
@@ -441,7 +452,7 @@ void loop()
 #endif
     {
 #ifdef PROTOCOL_MSP
-      if (timer.GUI_active == 0) {
+      if (timer.GUI_active == 0 && PROTOCOL_ACTIVE(PROTOCOL_ID_MSP) && serialTxReady(6)) {
         mspWriteRequest(MSP_ATTITUDE, 0);
       }
 #endif // PROTOCOL_MSP
@@ -451,140 +462,26 @@ void loop()
   
   }  // End of slow Timed Service Routine (100ms loop)
 
+#ifdef MAX7456_LOOP_DRAW
+  if ((currentMillis - previous_millis_high) >= hi_speed_cycle && MAX7456_FrameDone()) // Screen must not be rendered whilst being sent
+#else
   if ((currentMillis - previous_millis_high) >= hi_speed_cycle) // 33 Hz or 100hz in MSP high mode.
+#endif
   {
     previous_millis_high = previous_millis_high + hi_speed_cycle;
     uint16_t MSPcmdsend = 0;
+#ifdef MAX7456_LOOP_DRAW
+    uint8_t drawscreen = 0;
+#endif
+#ifndef MSP_SCHEDULER
     if (queuedMSPRequests == 0)
       queuedMSPRequests = modeMSPRequests;
-    uint32_t req = queuedMSPRequests & -queuedMSPRequests;
-    queuedMSPRequests &= ~req;
-    switch (req) {
-      case REQ_MSP_STATUS:
-        MSPcmdsend = MSP_STATUS;
-        break;
-#ifdef INTRO_FC
-      case REQ_MSP_FC_VERSION:
-        MSPcmdsend = MSP_FC_VERSION;
-        break;
-#endif
-      case REQ_MSP_RC:
-        MSPcmdsend = MSP_RC;
-        break;
-      case REQ_MSP_RAW_GPS:
-        MSPcmdsend = MSP_RAW_GPS;
-        break;
-      case REQ_MSP_COMP_GPS:
-        MSPcmdsend = MSP_COMP_GPS;
-        break;
-      case REQ_MSP_ATTITUDE:
-        MSPcmdsend = MSP_ATTITUDE;
-        break;
-      case REQ_MSP_ALTITUDE:
-        MSPcmdsend = MSP_ALTITUDE;
-        break;
-      case REQ_MSP_ANALOG:
-        MSPcmdsend = MSP_ANALOG;
-        break;
-      case REQ_MSP_MISC:
-        MSPcmdsend = MSP_MISC;
-        break;
-      case REQ_MSP_RC_TUNING:
-        MSPcmdsend = MSP_RC_TUNING;
-        break;
-      case REQ_MSP_PID_CONTROLLER:
-        MSPcmdsend = MSP_PID_CONTROLLER;
-        break;
-      case REQ_MSP_PID:
-        MSPcmdsend = MSP_PID;
-        break;
-#ifdef MENU_SERVO
-      case REQ_MSP_SERVO_CONF:
-        MSPcmdsend = MSP_SERVO_CONF;
-        break;
-#endif
-#ifdef USE_MSP_PIDNAMES
-      case REQ_MSP_PIDNAMES:
-        MSPcmdsend = MSP_PIDNAMES;
-        break;
-#endif
-#ifdef CORRECTLOOPTIME
-      case REQ_MSP_LOOP_TIME:
-        MSPcmdsend = MSP_LOOP_TIME;
-        break;
-#endif
-      case REQ_MSP_BOX:
-#ifdef BOXNAMES
-        MSPcmdsend = MSP_BOXNAMES;
-#else
-        MSPcmdsend = MSP_BOXIDS;
-#endif
-        break;
-      case REQ_MSP_FONT:
-        MSPcmdsend = MSP_OSD;
-        break;
-#if defined DEBUGMW
-      case REQ_MSP_DEBUG:
-        MSPcmdsend = MSP_DEBUG;
-        break;
-#endif
-#if defined SPORT
-      case REQ_MSP_CELLS:
-        MSPcmdsend = MSP_CELLS;
-        break;
-#endif
-#ifdef MULTIWII_V24
-      case REQ_MSP_NAV_STATUS:
-        if (MwSensorActive & mode.gpsmission)
-          MSPcmdsend = MSP_NAV_STATUS;
-        break;
-#endif
-#ifdef CORRECT_MSP_BF1
-      case REQ_MSP_CONFIG:
-        MSPcmdsend = MSP_CONFIG;
-        break;
-#endif
-#ifdef MENU_FIXEDWING
-      case REQ_MSP_FW_CONFIG:
-        MSPcmdsend = MSP_FW_CONFIG;
-        break;
-#endif
-#ifdef HAS_ALARMS
-      case REQ_MSP_ALARMS:
-        MSPcmdsend = MSP_ALARMS;
-        break;
-#endif
-#ifdef MSP_RTC_SUPPORT
-      case REQ_MSP_RTC:
-        MSPcmdsend = MSP_RTC;
-        break;
-#endif
-      case REQ_MSP_VOLTAGE_METER_CONFIG:
-        MSPcmdsend = MSP_VOLTAGE_METER_CONFIG;
-        break;
-#ifdef MSPV2
-      case REQ_MSP2_INAV_AIR_SPEED:
-        MSPcmdsend = MSP2_INAV_AIR_SPEED;
-        break;
-#endif
-#ifdef KISS
-      case REQ_MSP_KISS_TELEMTRY:
-        MSPcmdsend = MSP_KISS_TELEMTRY;
-        break;
-      case REQ_MSP_KISS_SETTINGS:
-        MSPcmdsend = MSP_KISS_SETTINGS;
-        break;
-      case REQ_MSP_KISS_MESSAGE:
-        MSPcmdsend = MSP_KISS_MESSAGE;
-        kissMessageToRequest = false;
-        break;
-#ifdef KISSGPS
-      case REQ_MSP_KISS_GPS:
-        MSPcmdsend = MSP_KISS_GPS;
-        break;
-#endif
-#endif
+    if (serialTxReady(MSP_REQUEST_LEN)) { // Stays queued until there is room
+      uint32_t req = queuedMSPRequests & -queuedMSPRequests;
+      queuedMSPRequests &= ~req;
+      MSPcmdsend = mspRequestCmd(req);
     }
+#endif // Requests sent by mspSchedule() otherwise
 
     if (!fontMode) {
 #ifdef KISS
@@ -606,23 +503,18 @@ void loop()
       if (!canvasMode)
 #endif // CANVAS_SUPPORT
       {
-        if (MSPcmdsend != 0) {
-#ifdef MSPV2
-          if (MSPcmdsend > 254) {
-            mspV2WriteRequest(MSPcmdsend, 0);
-          }
-          else
-#endif // MSPV2
-          {
-            mspWriteRequest(MSPcmdsend & 0xff, 0);
-          }
-        }
+        if (MSPcmdsend != 0)
+          mspSendRequest(MSPcmdsend);
       }
 #endif // KISS
 #ifdef CANVAS_SUPPORT
       if (!canvasMode)
 #endif // CANVAS_SUPPORT
+#ifdef MAX7456_LOOP_DRAW
+        drawscreen = 1; // Sent in background once the new screen is complete
+#else
         MAX7456_DrawScreen();
+#endif
     }
 
 #ifdef SBUS_CONTROL
@@ -741,8 +633,10 @@ void loop()
 #endif
         }
 #endif
+#ifndef RENDER_LIST
         displayHeadingGraph();
         displayHeading();
+#endif
 #if defined SUBMERSIBLE
  #if defined USEMS5837
         MwAltitude = (float)100 * MS5837sensor.depth();
@@ -754,6 +648,9 @@ void loop()
         }
 #endif // SUBMERSIBLE
 
+#ifdef RENDER_LIST
+        displayRenderList();
+#else
         if (fieldIsVisible(MwGPSAltPosition))
           displayAltitude(((int32_t)GPS_altitude*10),MwGPSAltPosition,SYM_GPS_ALT);
         if (fieldIsVisible(MwAltitudePosition))
@@ -775,6 +672,7 @@ void loop()
         displayWindSpeed(); // also windspeed if available
         displayItem(MAX_speedPosition, speedMAX, SYM_MAX, speedUnitAdd[Settings[S_UNITSYSTEM]], 0 );
         displayGPSPosition();
+#endif // RENDER_LIST
 #ifdef KISS
         displayVTXvalues();
 #else
@@ -807,6 +705,9 @@ void loop()
 #ifdef FC_MESSAGE
         displayFCMessage();
 #endif
+#ifdef FONT_PIPELINE
+        displayFontUpload();
+#endif
 #ifdef PHASERS  
         displayPhasers();
 #endif // PHASERS  
@@ -821,6 +722,10 @@ void loop()
 #endif
       }
     }
+#ifdef MAX7456_LOOP_DRAW
+    if (drawscreen)
+      MAX7456_BeginFrame();
+#endif
   }  // End of fast Timed Service Routine (50ms loop)
 
   if (timer.halfSec >= 5) {
@@ -851,6 +756,10 @@ void loop()
     if (timer.fcMessage > 0)
       timer.fcMessage--;
 #endif
+#ifdef FONT_PIPELINE
+    if (timer.fontMessage > 0)
+      timer.fontMessage--;
+#endif
 #ifdef ADSBAWARE
     if (timer.adsbttl > 0){
       timer.adsbttl--; 
@@ -883,6 +792,45 @@ void loop()
     serialrxrate = timer.serialrxrate;
     timer.serialrxrate = 0;
 #endif
+#if defined DEBUGDPOSOVERLAP && defined MAX7456_LOOP_DRAW
+    overlaprate = timer.overlapcount;
+    timer.overlapcount = 0;
+#endif
+#ifdef PROTOCOL_AUTODETECT
+    protocolCheck();
+#endif
+#ifdef BAUD_AUTODETECT
+    baudCheck();
+#endif
+#ifdef MAV_ADAPTIVE_RATE
+    mavRateCheck();
+#endif
+#ifdef DEBUGDPOSDECODE
+    decodetime = timer.decodemax;
+    timer.decodemax = 0;
+#endif
+#if defined DEBUGDPOSMAVSKIP && defined PROTOCOL_MAVLINK
+    mavskiprate = timer.mavskipped;
+    timer.mavskipped = 0;
+#endif
+#if defined DEBUGDPOSTX && defined SERIAL_TX_QUEUE
+    txdeferrate = timer.txdeferred;
+    timer.txdeferred = 0;
+#endif
+#if defined DEBUGDPOSMSPRTT && defined MSP_PIPELINE
+    mspreplyrate = timer.mspreplies;
+    msptimeoutrate = timer.msptimeouts;
+    msprtt = timer.mspreplies ? timer.msprttsum / timer.mspreplies / 100 : 0;
+    timer.mspreplies = 0;
+    timer.msptimeouts = 0;
+    timer.msprttsum = 0;
+#endif
+#if defined DEBUGDPOSMSPSCHED && defined MSP_SCHEDULER
+    for (uint8_t i = 0; i < MSP_SCHED_ENTRIES; i++) {
+      mspSchedRate[i] = mspSchedCount[i];
+      mspSchedCount[i] = 0;
+    }
+#endif
 #ifdef DEBUGDPOSMAV
   debug[0] = timer.d0rate;
   timer.d0rate=0;
@@ -956,6 +904,16 @@ void loop()
   }
   //  setMspRequests();
   serialMSPreceive(1);
+#ifdef FONT_PIPELINE
+  if (fontPipeline)
+    fontProcess();
+#endif
+#ifdef MSP_SCHEDULER
+  mspSchedule();
+#endif
+#if defined PROTOCOL_MAVLINK && defined SERIAL_TX_QUEUE && !defined BUDDYFLIGHT
+  request_mavlink_packets();
+#endif
 #ifdef FIXEDLOOP
   delay(1);
 #endif
@@ -983,10 +941,64 @@ void initFontMode() {
   // queue first char for transmition.
   retransmitQueue = 0x80;
   fontMode = 1;
+#ifdef FONT_PIPELINE
+  fontPipeline = 0;
+  fontQueueHead = 0;
+  fontQueueCount = 0;
+  fontNVMActive = 0;
+  fontEnd = 0;
+  fontUploadStart = millis();
+#endif
   //  setMspRequests();
 }
 
 
+#ifdef FONT_PIPELINE
+// Pipelined GUI upload, started by OSD_FONT_PIPELINE. Characters are queued
+// as received and written to NVM from loop, so the next characters arrive
+// while NVM is programmed. Each character written is acknowledged with
+// OSD_FONT_ACK. The GUI keeps up to FONT_QUEUE characters unacknowledged and
+// resends a character answered with OSD_FONT_NAK or not acknowledged in time.
+void fontQueueChar(uint8_t cindex) {
+  if (fontQueueCount == FONT_QUEUE) {
+    fontNakRequest(cindex);                  // GUI exceeded window
+    return;
+  }
+  struct __fontqueue *slot = &fontQueue[(fontQueueHead + fontQueueCount) % FONT_QUEUE];
+  slot->index = cindex;
+  memcpy(slot->data, serialBuffer + 1, sizeof(slot->data));
+  fontQueueCount++;
+}
+
+
+void fontProcess(void) {
+  if (fontNVMActive) {
+    if (MAX7456_NVMBusy())
+      return;
+    fontNVMActive = 0;
+  }
+  if (fontQueueCount == 0) {
+    if (fontEnd) {
+      MAX7456Setup();
+      fontMode = 0;
+      fontPipeline = 0;
+      fontUploadTime = (millis() - fontUploadStart) / 100;
+      timer.fontMessage = FONT_MESSAGE_TIME;
+    }
+    return;
+  }
+  struct __fontqueue *slot = &fontQueue[fontQueueHead];
+  fontNVMActive = MAX7456_StartNVM(slot->index, slot->data);
+  fontLastChar = slot->index;
+  if (fontLastChar == lastCharToRequest)
+    fontEnd = 1;
+  fontQueueHead = (fontQueueHead + 1) % FONT_QUEUE;
+  fontQueueCount--;
+  fontAckRequest();
+}
+#endif
+
+
 void fontCharacterReceived(uint8_t cindex) {
   if (!fontMode)
     return;
@@ -1183,8 +1195,22 @@ void setMspRequests() {
     if (MwSensorActive & mode.gpsmission)
       modeMSPRequests |= REQ_MSP_NAV_STATUS;
 #endif
+#ifdef WIDGET_SUBSCRIBE
+    if (!(telemetryUsed & TELEMETRY_GPS))
+      modeMSPRequests &= ~(REQ_MSP_RAW_GPS | REQ_MSP_COMP_GPS);
+    if (!(telemetryUsed & TELEMETRY_BARO))
+      modeMSPRequests &= ~REQ_MSP_ALTITUDE;
+    if (!(telemetryUsed & TELEMETRY_ATTITUDE))
+      modeMSPRequests &= ~REQ_MSP_ATTITUDE;
+    if (!(telemetryUsed & TELEMETRY_ANALOG))
+      modeMSPRequests &= ~REQ_MSP_ANALOG;
+#ifdef MSPV2
+    if (!(telemetryUsed & TELEMETRY_AIRSPEED))
+      modeMSPRequests &= ~REQ_MSP2_INAV_AIR_SPEED;
+#endif
+#endif // WIDGET_SUBSCRIBE
   }
-  if (timer.GUI_active != 0) {
+  if (timer.GUI_active != 0 || !PROTOCOL_ACTIVE(PROTOCOL_ID_MSP)) {
     modeMSPRequests = 0;
     queuedMSPRequests = 0;
   }
@@ -1192,6 +1218,263 @@ void setMspRequests() {
 }
 
 
+#ifdef WIDGET_SUBSCRIBE
+void buildTelemetryUsed(void) {
+  telemetryUsed = 0;
+  for (uint8_t pos = 0; pos < POSITIONS_SETTINGS; pos++) {
+    if (fieldIsVisible(pos))
+      telemetryUsed |= pgm_read_byte(&positionTelemetry[pos]);
+  }
+  // Consumers that run whatever the layout
+#if defined ALARM_SATS || defined ALARM_GPS
+  telemetryUsed |= TELEMETRY_GPS;                 // Sats and GPS lost alarms
+#endif
+#if !defined HIDESUMMARY && !defined SHORTSUMMARY
+  telemetryUsed |= TELEMETRY_GPS | TELEMETRY_BARO | TELEMETRY_AIRSPEED; // Summary trip, distance, altitude and speed
+#endif
+  if (Settings[S_MAINVOLTAGE_VBAT] == V_MAINVOLTAGE_VBAT_FROM_FLIGHTCONTROLLER ||
+      Settings[S_MWAMPERAGE] == 1 || Settings[S_MWRSSI] == V_MWRSSI_FROM_FLIGHTCONTROLLER)
+    telemetryUsed |= TELEMETRY_ANALOG;            // Voltage, current and RSSI alarms and summary
+}
+#endif // WIDGET_SUBSCRIBE
+
+
+// MSP command for a single REQ_MSP_ bit
+uint16_t mspRequestCmd(uint32_t req) {
+  switch (req) {
+    case REQ_MSP_STATUS:
+      return MSP_STATUS;
+#ifdef INTRO_FC
+    case REQ_MSP_FC_VERSION:
+      return MSP_FC_VERSION;
+#endif
+    case REQ_MSP_RC:
+      return MSP_RC;
+    case REQ_MSP_RAW_GPS:
+      return MSP_RAW_GPS;
+    case REQ_MSP_COMP_GPS:
+      return MSP_COMP_GPS;
+    case REQ_MSP_ATTITUDE:
+      return MSP_ATTITUDE;
+    case REQ_MSP_ALTITUDE:
+      return MSP_ALTITUDE;
+    case REQ_MSP_ANALOG:
+      return MSP_ANALOG;
+    case REQ_MSP_MISC:
+      return MSP_MISC;
+    case REQ_MSP_RC_TUNING:
+      return MSP_RC_TUNING;
+    case REQ_MSP_PID_CONTROLLER:
+      return MSP_PID_CONTROLLER;
+    case REQ_MSP_PID:
+      return MSP_PID;
+#ifdef MENU_SERVO
+    case REQ_MSP_SERVO_CONF:
+      return MSP_SERVO_CONF;
+#endif
+#ifdef USE_MSP_PIDNAMES
+    case REQ_MSP_PIDNAMES:
+      return MSP_PIDNAMES;
+#endif
+#ifdef CORRECTLOOPTIME
+    case REQ_MSP_LOOP_TIME:
+      return MSP_LOOP_TIME;
+#endif
+    case REQ_MSP_BOX:
+#ifdef BOXNAMES
+      return MSP_BOXNAMES;
+#else
+      return MSP_BOXIDS;
+#endif
+    case REQ_MSP_FONT:
+      return MSP_OSD;
+#if defined DEBUGMW
+    case REQ_MSP_DEBUG:
+      return MSP_DEBUG;
+#endif
+#if defined SPORT
+    case REQ_MSP_CELLS:
+      return MSP_CELLS;
+#endif
+#ifdef MULTIWII_V24
+    case REQ_MSP_NAV_STATUS:
+      if (MwSensorActive & mode.gpsmission)
+        return MSP_NAV_STATUS;
+      return 0;
+#endif
+#ifdef CORRECT_MSP_BF1
+    case REQ_MSP_CONFIG:
+      return MSP_CONFIG;
+#endif
+#ifdef MENU_FIXEDWING
+    case REQ_MSP_FW_CONFIG:
+      return MSP_FW_CONFIG;
+#endif
+#ifdef HAS_ALARMS
+    case REQ_MSP_ALARMS:
+      return MSP_ALARMS;
+#endif
+#ifdef MSP_RTC_SUPPORT
+    case REQ_MSP_RTC:
+      return MSP_RTC;
+#endif
+    case REQ_MSP_VOLTAGE_METER_CONFIG:
+      return MSP_VOLTAGE_METER_CONFIG;
+#ifdef MSPV2
+    case REQ_MSP2_INAV_AIR_SPEED:
+      return MSP2_INAV_AIR_SPEED;
+#endif
+#ifdef KISS
+    case REQ_MSP_KISS_TELEMTRY:
+      return MSP_KISS_TELEMTRY;
+    case REQ_MSP_KISS_SETTINGS:
+      return MSP_KISS_SETTINGS;
+    case REQ_MSP_KISS_MESSAGE:
+      kissMessageToRequest = false;
+      return MSP_KISS_MESSAGE;
+#ifdef KISSGPS
+    case REQ_MSP_KISS_GPS:
+      return MSP_KISS_GPS;
+#endif
+#endif
+  }
+  return 0;
+}
+
+
+#ifdef PROTOCOL_MSP
+void mspSendRequest(uint16_t cmd) {
+#ifdef MSPV2
+  if (cmd > 254) {
+    mspV2WriteRequest(cmd, 0);
+    return;
+  }
+#endif // MSPV2
+  mspWriteRequest(cmd & 0xff, 0);
+}
+#endif // PROTOCOL_MSP
+
+
+#ifdef MSP_SCHEDULER
+void mspSchedule(void) {
+  uint16_t now = millis();
+#ifdef MSP_PIPELINE
+  int8_t slot = mspPipelineSlot();
+  if (slot < 0)
+    return;
+#else
+  if ((uint16_t)(now - mspSchedTick) < MSP_SCHED_TICK)
+    return;
+  mspSchedTick = now;
+#endif
+#ifdef CANVAS_SUPPORT
+  if (fontMode || canvasMode)
+#else
+  if (fontMode)
+#endif
+    return;
+  if (!serialTxReady(MSP_REQUEST_LEN))
+    return;
+
+  uint32_t listed = 0;
+  int8_t next = -1;
+  uint8_t nextpriority = 0;
+  uint16_t nextlate = 0;
+  for (uint8_t i = 0; i < MSP_SCHED_ENTRIES; i++) {
+    uint32_t req = pgm_read_dword(&mspSchedTable[i].req);
+    uint32_t wanted = req ? req : modeMSPRequests & ~listed;
+    listed |= req;
+    if (!(modeMSPRequests & wanted))
+      continue;
+#ifdef MSP_PIPELINE
+    if (mspPipelineBusy(i))
+      continue;
+#endif
+    uint16_t elapsed = now - mspSchedSent[i];
+    uint16_t period = pgm_read_word(&mspSchedTable[i].period);
+    if (elapsed < period)
+      continue;
+    uint8_t priority = pgm_read_byte(&mspSchedTable[i].priority);
+    uint16_t late = elapsed - period;
+    if (next < 0 || priority > nextpriority || (priority == nextpriority && late > nextlate)) {
+      next = i;
+      nextpriority = priority;
+      nextlate = late;
+    }
+  }
+  if (next < 0)
+    return;
+
+  mspSchedSent[next] = now;
+#ifdef DEBUGDPOSMSPSCHED
+  mspSchedCount[next]++;
+#endif
+  uint32_t req = pgm_read_dword(&mspSchedTable[next].req);
+  if (req == 0) {
+    uint32_t others = modeMSPRequests & ~listed;
+    if ((queuedMSPRequests & others) == 0)
+      queuedMSPRequests = others;
+    req = queuedMSPRequests & others;
+    req &= -req;
+    queuedMSPRequests &= ~req;
+  }
+  uint16_t cmd = mspRequestCmd(req);
+  if (cmd == 0)
+    return;
+  mspSendRequest(cmd);
+#ifdef MSP_PIPELINE
+  mspOutstanding[slot].cmd = cmd;
+  mspOutstanding[slot].entry = next;
+  mspOutstanding[slot].sent = micros();
+#endif
+}
+#endif // MSP_SCHEDULER
+
+
+#ifdef MSP_PIPELINE
+// Free slot for a new request after expiring lost replies. -1 if all in use
+int8_t mspPipelineSlot(void) {
+  int8_t slot = -1;
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < MSP_PIPELINE_DEPTH; i++) {
+    if (mspOutstanding[i].cmd && (now - mspOutstanding[i].sent) > MSP_PIPELINE_TIMEOUT * 1000UL) {
+      mspOutstanding[i].cmd = 0;
+#ifdef DEBUGDPOSMSPRTT
+      timer.msptimeouts++;
+#endif
+    }
+    if (!mspOutstanding[i].cmd)
+      slot = i;
+  }
+  return slot;
+}
+
+
+uint8_t mspPipelineBusy(uint8_t entry) {
+  for (uint8_t i = 0; i < MSP_PIPELINE_DEPTH; i++) {
+    if (mspOutstanding[i].cmd && mspOutstanding[i].entry == entry)
+      return 1;
+  }
+  return 0;
+}
+
+
+// Called for every MSP frame received. Frees the slot of a matching request
+void mspPipelineReply(uint16_t cmd) {
+  for (uint8_t i = 0; i < MSP_PIPELINE_DEPTH; i++) {
+    if (mspOutstanding[i].cmd == cmd) {
+#ifdef DEBUGDPOSMSPRTT
+      timer.msprttsum += micros() - mspOutstanding[i].sent;
+      timer.mspreplies++;
+#endif
+      mspOutstanding[i].cmd = 0;
+      return;
+    }
+  }
+}
+#endif // MSP_PIPELINE
+
+
 void writeEEPROM(void) // OSD will only change 8 bit values. GUI changes directly
 {
   for (uint8_t en = 0; en < EEPROM_SETTINGS; en++) {
@@ -1278,6 +1561,12 @@ void readEEPROM(void)
       if (x > LINE09) screenPosition[en] = screenPosition[en] + LINE;
     }
   }
+#ifdef RENDER_LIST
+  buildRenderList();
+#endif
+#ifdef WIDGET_SUBSCRIBE
+  buildTelemetryUsed();
+#endif
 }
 
 
@@ -140,6 +140,7 @@ void MAX7456Setup(void)
   uint8_t MAX7456_reset=0x0C;
   uint8_t MAX_screen_rows;
 
+  MAX7456_WaitFrame();
   MAX7456DISABLE
 
   MAX7456HWRESET
@@ -211,6 +212,10 @@ void MAX7456Setup(void)
 #endif
   MAX7456DISABLE
 
+#ifdef DELTA_SCREEN_UPDATE
+  screenRefresh = 0; // MAX may have been reset. Resend everything
+#endif
+
 # ifdef USE_VSYNC
   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
     EIMSK |= (1 << INT0);  // enable interuppt
@@ -222,6 +227,45 @@ void MAX7456Setup(void)
 
 }
 
+#ifdef INVERTED_CHAR_SUPPORT
+// Attributes of each char are held as bit arrays. Values are MAX7456_ATTR_*
+// which match the DMM attribute bits.
+uint8_t MAX7456_GetAttr(uint16_t addr)
+{
+  uint8_t attr = 0;
+  if (bitISSET(screenAttr, addr))
+    attr |= MAX7456_ATTR_INV;
+#ifdef EXTENDED_CHAR_ATTR
+  if (bitISSET(screenBlink, addr))
+    attr |= MAX7456_ATTR_BLK;
+  if (bitISSET(screenLBC, addr))
+    attr |= MAX7456_ATTR_LBC;
+#endif
+  return attr;
+}
+
+void MAX7456_SetAttr(uint16_t addr, uint8_t attr)
+{
+  if (attr & MAX7456_ATTR_INV) {
+    bitSET(screenAttr, addr);
+  } else {
+    bitCLR(screenAttr, addr);
+  }
+#ifdef EXTENDED_CHAR_ATTR
+  if (attr & MAX7456_ATTR_BLK) {
+    bitSET(screenBlink, addr);
+  } else {
+    bitCLR(screenBlink, addr);
+  }
+  if (attr & MAX7456_ATTR_LBC) {
+    bitSET(screenLBC, addr);
+  } else {
+    bitCLR(screenLBC, addr);
+  }
+#endif
+}
+#endif
+
 // Copy string from ram into screen buffer
 
 #ifdef INVERTED_CHAR_SUPPORT
@@ -235,7 +279,7 @@ void MAX7456_WriteString(const char *string, int addr)
   MAX7456_WriteStringWithAttr(string, addr, 0);
 }
 
-void MAX7456_WriteStringWithAttr(const char *string, int addr, int attr)
+void MAX7456_WriteStringWithAttr(const char *string, int addr, uint8_t attr)
 #else
 void MAX7456_WriteString(const char *string, int addr)
 #endif
@@ -244,11 +288,7 @@ void MAX7456_WriteString(const char *string, int addr)
   while (*string) {
     *screenp++ = *string++;
 #ifdef INVERTED_CHAR_SUPPORT
-    if (attr) {
-      bitSET(screenAttr, addr);
-    } else {
-      bitCLR(screenAttr, addr);
-    }
+    MAX7456_SetAttr(addr, attr);
     addr++;
 #endif
   }
@@ -269,51 +309,223 @@ void MAX7456_ClearScreen(void)
   for(uint16_t xx = 0; xx < MAX_screen_size; ++xx) {
     screen[xx] = ' ';
 #ifdef INVERTED_CHAR_SUPPORT
-    bitCLR(screenAttr, xx);
+    MAX7456_SetAttr(xx, 0);
 #endif
   }
 }
 #endif
 
-#ifdef USE_VSYNC
-volatile unsigned char vsync_wait = 0;
+#ifdef DELTA_SCREEN_UPDATE
+// CRC8 of the DELTA_SCREEN_BLOCK chars starting at xx, each followed by its
+// attributes. A change to a single char or to a single char's attributes
+// always changes the signature. Other changes miss 1 time in 256 and are
+// corrected by the next DELTA_SCREEN_REFRESH.
+uint8_t MAX7456_BlockSignature(uint16_t xx)
+{
+  uint8_t sig = 0;
+  for (uint8_t i = 0; i < DELTA_SCREEN_BLOCK; i++, xx++) {
+    sig = crc8_dvb_s2_update(sig, screen[xx]);
+#ifdef INVERTED_CHAR_SUPPORT
+    sig = crc8_dvb_s2_update(sig, MAX7456_GetAttr(xx));
+#endif
+  }
+  return sig;
+}
+#endif
 
-ISR(INT0_vect) {
-    vsync_wait = 0;
+// Screen update transmitter. The bytes needed for each cell are prepared into
+// a small queue which is drained either by MAX7456_DrawScreen or, with
+// MAX7456_LOOP_DRAW, a chunk at a time by MAX7456_DrawNext from loop().
+// Display memory is written as 8 bit auto increment runs: DMAH/DMAL/DMM then
+// char data only, ended by END_string. Char 0xFF therefore cannot be displayed
+// and is sent as a blank, as screen[] can hold any byte from the FC.
+// Each run covers consecutive chars with the same attributes.
+uint8_t drawQueue[8];
+uint8_t drawQueueHead;                // Next queued byte to send
+uint8_t drawQueueTail;                // Number of queued bytes
+uint16_t drawPos;                     // Next cell to prepare
+uint8_t drawRunAttr;                  // DMM attribute of active run. END_string = no run
+volatile uint8_t drawActive = 0;
+#if defined DEBUGDPOSSPI && defined DELTA_SCREEN_UPDATE
+uint16_t drawBytes;
+#endif
+#ifdef DEBUGDPOSPUSH
+uint16_t drawStart;
+#endif
+#ifdef DELTA_SCREEN_UPDATE
+uint8_t screenDirty[(480/DELTA_SCREEN_BLOCK+7)/8]; // Blocks to send this frame
+#endif
+
+void MAX7456_QueueByte(uint8_t data)
+{
+  drawQueue[drawQueueTail++] = data;
 }
 
-void MAX7456_WaitVSYNC(void)
+// Queues the bytes for the next cell needing an update.
+// Returns 0 when the frame is complete.
+uint8_t MAX7456_PrepareNext(void)
 {
-  uint32_t vsync_timer = 40 + millis();
+  drawQueueHead = 0;
+  drawQueueTail = 0;
+  while (drawPos < MAX_screen_size) {
+    uint16_t xx = drawPos;
+#ifdef DELTA_SCREEN_UPDATE
+    if ((xx % DELTA_SCREEN_BLOCK) == 0 && bitISCLR(screenDirty, xx / DELTA_SCREEN_BLOCK)) {
+      // Unchanged block. Already cleared by MAX7456_BeginFrame
+      drawPos += DELTA_SCREEN_BLOCK;
+      if (drawPos > MAX_screen_size)
+        drawPos = MAX_screen_size;
+      if (drawRunAttr == END_string)
+        continue;
+      MAX7456_QueueByte(END_string);
+      drawRunAttr = END_string;
+      break;
+    }
+#endif
+    uint8_t attr = 0;
+#ifdef INVERTED_CHAR_SUPPORT
+    attr = MAX7456_GetAttr(xx);
+    MAX7456_SetAttr(xx, 0);
+#endif
+    if (attr != drawRunAttr) {
+      if (drawRunAttr != END_string)
+        MAX7456_QueueByte(END_string);
+      MAX7456_QueueByte(MAX7456ADD_DMAH);
+      MAX7456_QueueByte(xx >> 8);
+      MAX7456_QueueByte(MAX7456ADD_DMAL);
+      MAX7456_QueueByte(xx);
+      MAX7456_QueueByte(MAX7456ADD_DMM);
+      MAX7456_QueueByte(attr | 1);
+      drawRunAttr = attr;
+    }
+    MAX7456_QueueByte(screen[xx] == (char)END_string ? ' ' : screen[xx]);
+    screen[xx] = ' ';
+    drawPos++;
+    break;
+  }
+  if (drawQueueTail == 0 && drawPos == MAX_screen_size) {
+    drawPos++; // Trailer queued
+    if (drawRunAttr != END_string)
+      MAX7456_QueueByte(END_string);
+    MAX7456_QueueByte(MAX7456ADD_DMM);
+    MAX7456_QueueByte(0);
+  }
+#if defined DEBUGDPOSSPI && defined DELTA_SCREEN_UPDATE
+  drawBytes += drawQueueTail;
+#endif
+  return drawQueueTail;
+}
 
-  vsync_wait = 1;
+void MAX7456_EndFrame(void)
+{
+  MAX7456DISABLE
+#if defined DEBUGDPOSSPI && defined DELTA_SCREEN_UPDATE
+  spisaved = MAX_screen_size + 9 - drawBytes;
+#endif
+#ifdef DEBUGDPOSPUSH
+  pushtime = (uint16_t)micros() - drawStart;
+#endif
+  drawActive = 0;
+}
 
-  while (vsync_wait) {
-    if (millis() > vsync_timer){
-      vsync_wait=0;
-    } else{
-//      serialMSPreceive(0); // Might as well do something whilst waiting :)
+#ifdef MAX7456_LOOP_DRAW
+// Sends up to MAX7456_DRAW_CHUNK bytes of the frame in progress.
+// Returns 0 when the frame is complete
+uint8_t MAX7456_SendChunk(void)
+{
+  for (uint8_t count = MAX7456_DRAW_CHUNK; count; count--) {
+    if (drawQueueHead == drawQueueTail && !MAX7456_PrepareNext()) {
+      MAX7456_EndFrame();
+      return 0;
     }
+    spi_transfer(drawQueue[drawQueueHead++]);
   }
+  return 1;
+}
+
+#ifdef USE_VSYNC
+// After each VSYNC the frame is sent for VSYNC_WINDOW us, while the field is
+// blanked, so display memory writes do not disturb the picture. A full screen
+// normally fits one field, as with the blocking VSYNC wait this replaces.
+volatile uint32_t lastVSYNC = 0;
+volatile uint16_t lastVSYNCus = 0;
+volatile uint8_t drawFields;          // VSYNCs since the frame started
+
+ISR(INT0_vect)
+{
+  lastVSYNC = millis();
+  lastVSYNCus = micros();
+  if (drawActive)
+    drawFields++;
 }
 #endif
 
-void MAX7456_DrawScreen()
+// Sends the next part of the frame in progress. Called from loop() with
+// interrupts enabled so serial receive is never held off. With USE_VSYNC
+// chunks are sent until the blanking window ends, otherwise one per call
+void MAX7456_DrawNext(void)
 {
-  uint16_t xx;
+  if (!drawActive)
+    return;
+#ifdef USE_VSYNC
+  uint16_t since;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if ((millis() - lastVSYNC) > VSYNC_TIMEOUT) { // No VSYNC. e.g. no camera connected
+      lastVSYNC = millis();
+      lastVSYNCus = micros();
+      drawFields++;
+    }
+  }
+#ifdef DEBUGDPOSFIELD
+  uint16_t sent = 0;
+#endif
+  for (;;) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      since = (uint16_t)micros() - lastVSYNCus;
+    }
+    if (drawFields == 0 || since > VSYNC_WINDOW)
+      break;                          // Wait for the next VSYNC
+#ifdef DEBUGDPOSFIELD
+    sent += MAX7456_DRAW_CHUNK;
+#endif
+    if (!MAX7456_SendChunk()) {
+#ifdef DEBUGDPOSFIELD
+      framefields = drawFields;
+#endif
+      break;
+    }
+  }
+#ifdef DEBUGDPOSFIELD
+  if (sent)
+    fieldbytes = sent;
+#endif
+#else
+  MAX7456_SendChunk();
+#endif
+}
+#endif
 
-  MAX7456ENABLE;
+// Waits for any screen update in progress. Required before other MAX7456 access
+void MAX7456_WaitFrame(void)
+{
+#ifdef MAX7456_LOOP_DRAW
+  while (drawActive)
+    MAX7456_DrawNext();
+#endif
+}
 
-  MAX7456_Send(MAX7456ADD_DMAH, 0);
-  MAX7456_Send(MAX7456ADD_DMAL, 0);
-  MAX7456_Send(MAX7456ADD_DMM, 1);
+uint8_t MAX7456_FrameDone(void)
+{
+  return !drawActive;
+}
 
-#ifdef USE_VSYNC
-  MAX7456_WaitVSYNC();
-#endif
+// Starts sending screen[] to the MAX7456. Cells are cleared as they are sent
+void MAX7456_BeginFrame(void)
+{
+  MAX7456_WaitFrame();
 
 #ifdef SCREENTEST
-   for(xx = 0; xx < MAX_screen_size; ++xx) {
+   for(uint16_t xx = 0; xx < MAX_screen_size; ++xx) {
      screen[xx] = 48 + (xx %10) ;
       if ((xx%30)==8)
         screen[xx] = 48 + ((xx/30) % 10) ; 
@@ -329,39 +541,66 @@ void MAX7456_DrawScreen()
    }      
 #endif // SCREENTEST
 
-
-  for(xx = 0; xx < MAX_screen_size; ++xx) {
-#ifdef USE_VSYNC
-    // We don't actually need this?
-    if (xx == 240)
-        MAX7456_WaitVSYNC(); // Don't need this?
-#endif
-
-#ifdef INVERTED_CHAR_SUPPORT
-    bool invActive = false;
-    if (!invActive && bitISSET(screenAttr, xx)) {
-      MAX7456_Send(MAX7456ADD_DMM, 1|(1<<3));
-      invActive = true;
-    } else if (invActive && bitISCLR(screenAttr, xx)) {
-      MAX7456_Send(MAX7456ADD_DMM, 1);
-      invActive = false;
+#ifdef DELTA_SCREEN_UPDATE
+  // Only blocks whose signature differs from the shadow are sent.
+  // Unchanged blocks are cleared here so the transmitter can skip them.
+  uint8_t fullupdate = 0;
+  if (screenRefresh == 0) {
+    fullupdate = 1;
+    screenRefresh = DELTA_SCREEN_REFRESH;
+  }
+  screenRefresh--;
+  for (uint16_t xx = 0; xx < MAX_screen_size; xx += DELTA_SCREEN_BLOCK) {
+    uint8_t block = xx / DELTA_SCREEN_BLOCK;
+    uint8_t sig = MAX7456_BlockSignature(xx);
+    if (fullupdate || sig != screenShadow[block]) {
+      bitSET(screenDirty, block);
     }
+    else {
+      bitCLR(screenDirty, block);
+      for (uint8_t i = 0; i < DELTA_SCREEN_BLOCK; i++) {
+        screen[xx + i] = ' ';
+#ifdef INVERTED_CHAR_SUPPORT
+        MAX7456_SetAttr(xx + i, 0);
 #endif
-   
-    MAX7456_Send(MAX7456ADD_DMDI, screen[xx]);
-
-    {
-      screen[xx] = ' ';
-    #ifdef INVERTED_CHAR_SUPPORT
-      bitCLR(screenAttr, xx);
-    #endif
+      }
     }
+    screenShadow[block] = sig;
   }
+#endif
+
+  drawPos = 0;
+  drawQueueHead = 0;
+  drawQueueTail = 0;
+  drawRunAttr = END_string;
+#if defined DEBUGDPOSSPI && defined DELTA_SCREEN_UPDATE
+  drawBytes = 0;
+#endif
+#ifdef DEBUGDPOSPUSH
+  drawStart = micros();
+#endif
 
-  MAX7456_Send(MAX7456ADD_DMDI, END_string);
-  MAX7456_Send(MAX7456ADD_DMM, 0);
+  MAX7456ENABLE;
 
-  MAX7456DISABLE
+#ifdef USE_VSYNC
+  drawFields = 0;                 // Sending starts at the next VSYNC
+#endif
+  drawActive = 1;
+}
+
+// Sends screen[] to the MAX7456 and waits for completion
+void MAX7456_DrawScreen()
+{
+  MAX7456_BeginFrame();
+#ifdef MAX7456_LOOP_DRAW
+  MAX7456_WaitFrame();
+#else
+  while (MAX7456_PrepareNext()) {
+    while (drawQueueHead < drawQueueTail)
+      spi_transfer(drawQueue[drawQueueHead++]);
+  }
+  MAX7456_EndFrame();
+#endif
 }
 
 void MAX7456_Send(uint8_t add, uint8_t data)
@@ -385,39 +624,125 @@ void MAX7456_Send(uint8_t add, uint8_t data)
 //#define MAX7456_reset 0x02
 #define DISABLE_display 0x00
 #define STATUS_reg_nvr_busy 0x20
+#define READ_nvr 0x50
+#define MAX7456ADD_CMDO 0xC0
 
-void write_NVM(uint8_t char_address)
+#ifdef FONT_SYNC
+// Reads a character from NVM into shadow ram. Display must be disabled
+void read_NVM(uint8_t char_address)
 {
-#ifdef WRITE_TO_MAX7456
-  // disable display
+  MAX7456_Send(MAX7456ADD_CMAH, char_address);
+  MAX7456_Send(MAX7456ADD_CMM, READ_nvr);
+}
+
+uint8_t read_CMDO(uint8_t x)
+{
+  MAX7456_Send(MAX7456ADD_CMAL, x);
+  spi_transfer(MAX7456ADD_CMDO);
+  return spi_transfer(0xFF);
+}
+
+// CRC16 CCITT (0x1021, init 0) of the 54 bytes of all 256 characters in NVM
+uint16_t fontChecksum(void)
+{
+  uint16_t crc = 0;
+  MAX7456_WaitFrame();
   MAX7456ENABLE
   MAX7456_Send(MAX7456ADD_VM0, VIDEO_MODE);
+  for (uint16_t c = 0; c < 256; c++) {
+    read_NVM(c);
+    for (uint8_t x = 0; x < NVM_ram_size; x++) {
+      crc ^= (uint16_t)read_CMDO(x) << 8;
+      for (uint8_t i = 0; i < 8; i++)
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  MAX7456_Send(MAX7456ADD_VM0, OSD_ENABLE|VERTICAL_SYNC_NEXT_VSYNC|VIDEO_MODE);
+  MAX7456DISABLE
+  return crc;
+}
+#endif
+
+// Loads a character into shadow ram and starts the NVM write. Display must be disabled
+// Returns 0 if the character already matched NVM and was not written
+uint8_t MAX7456_LoadNVM(uint8_t char_address, uint8_t *data)
+{
+#ifdef FONT_SYNC
+  read_NVM(char_address);
+  uint8_t x = 0;
+  while (x < NVM_ram_size && read_CMDO(x) == data[x])
+    x++;
+  if (x == NVM_ram_size)
+    return 0;
+#endif
 
   MAX7456_Send(MAX7456ADD_CMAH, char_address); // set start address high
 
   for(uint8_t x = 0; x < NVM_ram_size; x++) // write out 54 bytes of character to shadow ram
   {
     MAX7456_Send(MAX7456ADD_CMAL, x); // set start address low
-    MAX7456_Send(MAX7456ADD_CMDI, serialBuffer[1+x]);
+    MAX7456_Send(MAX7456ADD_CMDI, data[x]);
   }
 
   // transfer 54 bytes from shadow ram to NVM
   MAX7456_Send(MAX7456ADD_CMM, WRITE_nvr);
+  return 1;
+}
+
+// Returns 0 if the character already matched NVM and was not written
+uint8_t write_NVM(uint8_t char_address)
+{
+#ifdef WRITE_TO_MAX7456
+  MAX7456_WaitFrame();
+  // disable display
+  MAX7456ENABLE
+  MAX7456_Send(MAX7456ADD_VM0, VIDEO_MODE);
+
+  uint8_t written = MAX7456_LoadNVM(char_address, serialBuffer + 1);
   
   // wait until bit 5 in the status register returns to 0 (12ms)
-  while ((spi_transfer(MAX7456ADD_STAT) & STATUS_reg_nvr_busy) != 0x00);
+  if (written)
+    while ((spi_transfer(MAX7456ADD_STAT) & STATUS_reg_nvr_busy) != 0x00);
 
   MAX7456_Send(MAX7456ADD_VM0, OSD_ENABLE|VERTICAL_SYNC_NEXT_VSYNC|VIDEO_MODE); // turn on screen next vertical
   MAX7456DISABLE  
-  delay(20);
+  if (written)
+    delay(20);
+  return written;
 #else
   delay(12);
+  return 1;
 #endif
 }
 
+#ifdef FONT_PIPELINE
+uint8_t MAX7456_NVMBusy(void)
+{
+  MAX7456_WaitFrame();
+  MAX7456ENABLE
+  spi_transfer(MAX7456ADD_STAT);
+  uint8_t busy = spi_transfer(0xFF) & STATUS_reg_nvr_busy;
+  MAX7456DISABLE
+  return busy;
+}
+
+// Starts the NVM write of a character without waiting for it to complete.
+// Display stays disabled until MAX7456Setup
+uint8_t MAX7456_StartNVM(uint8_t char_address, uint8_t *data)
+{
+  MAX7456_WaitFrame();
+  MAX7456ENABLE
+  MAX7456_Send(MAX7456ADD_VM0, VIDEO_MODE);
+  uint8_t written = MAX7456_LoadNVM(char_address, data);
+  MAX7456DISABLE
+  return written;
+}
+#endif
+
 #if defined(AUTOCAM) || defined(MAXSTALLDETECT)
 void MAX7456CheckStatus(void){
   uint8_t srdata;
+  MAX7456_WaitFrame();
   MAX7456ENABLE
 
 #ifdef AUTOCAM
@@ -455,7 +780,7 @@ void updateFont()
     for(uint8_t i = 0; i < 54; i++){
       serialBuffer[1+i] = (uint8_t)pgm_read_byte(fontdata+(64*x)+i);
     }
-    write_NVM(x);
+    uint8_t written = write_NVM(x);
     ledstatus=!ledstatus;
     if (ledstatus==true){
       digitalWrite(LEDPIN,HIGH);
@@ -463,7 +788,8 @@ void updateFont()
     else{
       digitalWrite(LEDPIN,LOW);
     }
-    delay(20); // Shouldn't be needed due to status reg wait.
+    if (written)
+      delay(20); // Shouldn't be needed due to status reg wait.
   }
 }
 #endif
@@ -0,0 +1,368 @@
+/*
+  OSDSerial.cpp
+
+  Interrupt driven USART0 port with MSP frame assembly or a byte ring in the
+  RX interrupt. See OSDSerial.h
+*/
+
+#include "Arduino.h"
+#include "Config.h"
+#include "Def.h"
+
+#ifdef OSD_SERIAL
+
+#include "OSDSerial.h"
+#include "crc8.h"
+
+static uint8_t txstarted;
+#ifdef SERIAL_TX_QUEUE
+static uint8_t txbuffer[SERIAL_TX_BUFFER];
+static volatile uint8_t txhead;     // Next byte written
+static volatile uint8_t txtail;     // Next byte sent
+#endif
+
+#ifdef SERIAL_RX_RING
+static uint8_t rxbuffer[SERIAL_RX_BUFFER];
+static volatile uint8_t rxhead;     // Next byte received
+static uint8_t rxtail;              // Next byte read
+
+
+ISR(USART_RX_vect)
+{
+  uint8_t status = UCSR0A;
+  uint8_t c = UDR0;
+
+  if (status & (1 << FE0)) {
+    OSDSerial.framing++;
+    return;
+  }
+  if (status & (1 << DOR0))         // Bytes lost before this one
+    OSDSerial.overflow++;
+  uint8_t next = (uint8_t)(rxhead + 1) & (SERIAL_RX_BUFFER - 1);
+  if (next == rxtail) {
+    OSDSerial.overflow++;
+    return;
+  }
+  rxbuffer[rxhead] = c;
+  rxhead = next;
+}
+#endif // SERIAL_RX_RING
+
+
+#ifdef MSP_RX_ISR
+static struct __mspframe frames[MSP_RX_FRAMES];
+static uint8_t frameHead;           // Oldest complete frame
+static uint8_t frameTail;           // Frame being received
+static volatile uint8_t frameCount; // Complete frames queued
+static volatile uint16_t rxcount;
+
+static enum {
+  IDLE,
+  HEADER_START,
+  HEADER_MX,
+  HEADER_ARROW,
+  HEADER_SIZE,
+  PAYLOAD_READY,
+#ifdef MSPV2
+  HEADER_CMD1_MSPV2,
+  HEADER_CMD2_MSPV2,
+  HEADER_SIZE1_MSPV2,
+#endif
+}
+c_state = IDLE;
+
+static uint8_t MSPversion;
+static uint8_t rcvChecksum;
+static uint8_t receiverIndex;
+static uint16_t dataSize;
+static uint16_t cmdMSP;
+static uint8_t discard;             // Frame queue was full when frame started
+
+
+static void frameComplete(void)
+{
+  if (discard)
+    OSDSerial.overflow++;
+  else {
+    frames[frameTail].cmd = cmdMSP;
+    frames[frameTail].size = dataSize;
+    if (++frameTail == MSP_RX_FRAMES)
+      frameTail = 0;
+    frameCount++;
+  }
+  c_state = IDLE;
+}
+
+
+static void frameStart(void)
+{
+  receiverIndex = 0;
+  discard = frameCount >= MSP_RX_FRAMES;
+  c_state = PAYLOAD_READY;
+}
+
+
+ISR(USART_RX_vect)
+{
+  uint8_t c = UDR0;
+
+  rxcount++;
+  if (c_state == IDLE) {
+    c_state = (c == '$') ? HEADER_START : IDLE;
+    MSPversion = 1;
+  }
+  else if (c_state == HEADER_START) {
+    c_state = IDLE;
+    if (c == 'M')
+      c_state = HEADER_MX;
+#ifdef MSPV2
+    if (c == 'X') {
+      c_state = HEADER_MX;
+      MSPversion = 2;
+    }
+#endif
+  }
+  else if (c_state == HEADER_MX) {
+    c_state = (c == '>') ? HEADER_ARROW : IDLE;
+  }
+  else if (c_state == HEADER_ARROW) {
+    c_state = HEADER_SIZE;
+    rcvChecksum = crc8_dvb_s2(0, c, MSPversion);
+    if (MSPversion == 1) {
+      dataSize = c;
+      if (dataSize > MSP_RX_FRAMESIZE) {
+        OSDSerial.dropped++;
+        c_state = IDLE;
+      }
+    }
+  }
+  else if (c_state == HEADER_SIZE) {
+    rcvChecksum = crc8_dvb_s2(rcvChecksum, c, MSPversion);
+    cmdMSP = c;
+#ifdef MSPV2
+    if (MSPversion == 2)
+      c_state = HEADER_CMD1_MSPV2;
+    else
+#endif
+      frameStart();
+  }
+#ifdef MSPV2
+  else if (c_state == HEADER_CMD1_MSPV2) {
+    rcvChecksum = crc8_dvb_s2(rcvChecksum, c, MSPversion);
+    cmdMSP += (uint16_t)(c << 8);
+    c_state = HEADER_CMD2_MSPV2;
+  }
+  else if (c_state == HEADER_CMD2_MSPV2) {
+    rcvChecksum = crc8_dvb_s2(rcvChecksum, c, MSPversion);
+    dataSize = c;
+    c_state = HEADER_SIZE1_MSPV2;
+  }
+  else if (c_state == HEADER_SIZE1_MSPV2) {
+    rcvChecksum = crc8_dvb_s2(rcvChecksum, c, MSPversion);
+    dataSize += (uint16_t)(c << 8);
+    if (dataSize > MSP_RX_FRAMESIZE) {
+      OSDSerial.dropped++;
+      c_state = IDLE;
+    }
+    else
+      frameStart();
+  }
+#endif
+  else if (c_state == PAYLOAD_READY) {
+#ifdef FLIGHTONE_MSP
+    if (cmdMSP == 101 && dataSize == 11 && receiverIndex == 10) { // F1 versions with bug. No checksum
+      frameComplete();
+      return;
+    }
+#endif
+    if (receiverIndex == dataSize) { // received checksum byte
+      if (rcvChecksum == c)
+        frameComplete();
+      else {
+        OSDSerial.dropped++;
+        c_state = IDLE;
+      }
+    }
+    else {
+      rcvChecksum = crc8_dvb_s2(rcvChecksum, c, MSPversion);
+      if (!discard)
+        frames[frameTail].data[receiverIndex] = c;
+      receiverIndex++;
+    }
+  }
+}
+#endif // MSP_RX_ISR
+
+
+#ifdef SERIAL_TX_QUEUE
+static void txSend(void)
+{
+  UDR0 = txbuffer[txtail];
+  txtail = (txtail + 1) & (SERIAL_TX_BUFFER - 1);
+  UCSR0A = (UCSR0A & (1 << U2X0)) | (1 << TXC0); // clear transmit complete
+  if (txhead == txtail)
+    UCSR0B &= ~(1 << UDRIE0);
+}
+
+
+ISR(USART_UDRE_vect)
+{
+  txSend();
+}
+#endif
+
+
+void OSDSerialPort::begin(unsigned long baud)
+{
+  uint16_t setting = (F_CPU / 4 / baud - 1) / 2; // double speed asynch mode
+  UCSR0A = 1 << U2X0;
+  UBRR0H = setting >> 8;
+  UBRR0L = setting;
+  UCSR0C = SERIAL_8N1;
+  UCSR0B = (1 << RXEN0) | (1 << TXEN0) | (1 << RXCIE0);
+  txstarted = 0;
+#ifdef SERIAL_RX_RING
+  rxhead = rxtail = 0;
+#endif
+#ifdef SERIAL_TX_QUEUE
+  txhead = txtail = 0;
+#endif
+}
+
+
+void OSDSerialPort::end()
+{
+  flush();
+  UCSR0B = 0;
+}
+
+
+size_t OSDSerialPort::write(uint8_t c)
+{
+#ifdef SERIAL_TX_QUEUE
+  uint8_t next = (txhead + 1) & (SERIAL_TX_BUFFER - 1);
+  while (next == txtail) {          // Full. Send from here if interrupts are off
+    if (!(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0)))
+      txSend();
+  }
+  txbuffer[txhead] = c;
+  uint8_t oldSREG = SREG;
+  cli();
+  txhead = next;
+  UCSR0B |= 1 << UDRIE0;
+  SREG = oldSREG;
+  txstarted = 1;
+  return 1;
+#else
+  while (!(UCSR0A & (1 << UDRE0)))
+    ;
+  UDR0 = c;
+  UCSR0A = (UCSR0A & (1 << U2X0)) | (1 << TXC0); // clear transmit complete
+  txstarted = 1;
+  return 1;
+#endif
+}
+
+
+#ifdef SERIAL_RX_RING
+int OSDSerialPort::available(void)
+{
+  return (uint8_t)(rxhead - rxtail) & (SERIAL_RX_BUFFER - 1);
+}
+
+
+int OSDSerialPort::read(void)
+{
+  if (rxhead == rxtail)
+    return -1;
+  uint8_t c = rxbuffer[rxtail];
+  rxtail = (uint8_t)(rxtail + 1) & (SERIAL_RX_BUFFER - 1);
+  return c;
+}
+
+
+int OSDSerialPort::peek(void)
+{
+  if (rxhead == rxtail)
+    return -1;
+  return rxbuffer[rxtail];
+}
+#else
+int OSDSerialPort::available(void)
+{
+  return 0;
+}
+
+
+int OSDSerialPort::read(void)
+{
+  return -1;
+}
+
+
+int OSDSerialPort::peek(void)
+{
+  return -1;
+}
+#endif // SERIAL_RX_RING
+
+
+#ifdef SERIAL_TX_QUEUE
+int OSDSerialPort::availableForWrite(void)
+{
+  return (uint8_t)(txtail - txhead - 1) & (SERIAL_TX_BUFFER - 1);
+}
+#endif
+
+
+void OSDSerialPort::flush(void)
+{
+  if (!txstarted)
+    return;
+#ifdef SERIAL_TX_QUEUE
+  while (txhead != txtail) {
+    if (!(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0)))
+      txSend();
+  }
+#endif
+  while (!(UCSR0A & (1 << TXC0)))
+    ;
+}
+
+
+#ifdef MSP_RX_ISR
+struct __mspframe *OSDSerialPort::frame(void)
+{
+  if (frameCount == 0)
+    return NULL;
+  return &frames[frameHead];
+}
+
+
+void OSDSerialPort::frameDone(void)
+{
+  if (++frameHead == MSP_RX_FRAMES)
+    frameHead = 0;
+  uint8_t oldSREG = SREG;
+  cli();
+  frameCount--;
+  SREG = oldSREG;
+}
+
+
+uint16_t OSDSerialPort::rxBytes(void)
+{
+  uint16_t count;
+  uint8_t oldSREG = SREG;
+  cli();
+  count = rxcount;
+  rxcount = 0;
+  SREG = oldSREG;
+  return count;
+}
+#endif // MSP_RX_ISR
+
+
+OSDSerialPort OSDSerial;
+
+#endif // OSD_SERIAL
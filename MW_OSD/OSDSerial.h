@@ -0,0 +1,64 @@
+/*
+  OSDSerial.h
+
+  Interrupt driven USART0 port. Used instead of the Arduino Serial port when
+  MSP_RX_ISR or SERIAL_RX_RING is enabled.
+
+  MSP_RX_ISR: MSP frames are assembled and checksummed in the RX complete
+  interrupt and queued until serialMSPreceive consumes them, so frames are
+  not lost while loop is busy drawing the screen, writing NVM or reading
+  sensors.
+
+  SERIAL_RX_RING: Bytes are queued in a SERIAL_RX_BUFFER ring for any
+  protocol. With SERIAL_TX_QUEUE writes are buffered and sent by the
+  data register empty interrupt.
+*/
+
+#ifndef OSDSerial_h
+#define OSDSerial_h
+
+#include <inttypes.h>
+#include "Stream.h"
+
+#ifdef MSP_RX_ISR
+struct __mspframe {
+  uint16_t cmd;                     // 8 bit for MSP or 16 bit for MSPV2
+  uint8_t  size;
+  uint8_t  data[MSP_RX_FRAMESIZE];
+};
+#endif
+
+class OSDSerialPort : public Stream
+{
+  public:
+    void begin(unsigned long);
+    void end();
+
+    virtual size_t write(uint8_t);
+    virtual int available(void);    // Always 0 with MSP_RX_ISR. MSP frames only
+    virtual int read(void);
+    virtual int peek(void);
+    virtual void flush(void);
+#ifdef SERIAL_TX_QUEUE
+    int availableForWrite(void);    // Bytes that can be written without waiting
+#endif
+    using Print::write;
+
+#ifdef MSP_RX_ISR
+    struct __mspframe *frame(void); // Oldest complete frame or NULL
+    void frameDone(void);           // Releases oldest frame
+    uint16_t rxBytes(void);         // Bytes received since last call
+
+    volatile uint16_t overflow;     // Frames lost with frame queue full
+    volatile uint16_t dropped;      // Frames with bad checksum or too large
+#else
+    volatile uint16_t overflow;     // Bytes lost with ring full or not read in time by the interrupt
+    volatile uint16_t framing;      // Bytes with framing errors. Usually wrong baud rate
+#endif
+};
+
+extern OSDSerialPort OSDSerial;
+
+#define Serial OSDSerial
+
+#endif
@@ -338,6 +338,20 @@ void displayFCMessage(void)
 }
 #endif
 
+#ifdef FONT_PIPELINE
+void displayFontUpload(void)
+{
+  if (timer.fontMessage == 0)
+    return;
+  uint16_t pos = 8 + (LINE * (getPosition(motorArmedPosition) / LINE));
+  MAX7456_WriteString_P(fontupload_text, pos);
+  ItoaPadded(fontUploadTime, screenBuffer, 5, 4);
+  screenBuffer[5] = 'S';
+  screenBuffer[6] = 0;
+  MAX7456_WriteString(screenBuffer, pos + 12);
+}
+#endif
+
 void displayHorizon(int rollAngle, int pitchAngle)
 {
 #ifdef DISPLAY_PR
@@ -2189,6 +2203,108 @@ void displayDebug(void)
   itoa(serialrxrate, screenBuffer, 10);
   MAX7456_WriteString(screenBuffer, DEBUGDPOSRX + 5);
 #endif
+#if defined DEBUGDPOSSPI && defined DELTA_SCREEN_UPDATE
+  MAX7456_WriteString("SPI", DEBUGDPOSSPI);
+  itoa(spisaved, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSSPI + 5);
+#endif
+#ifdef DEBUGDPOSPUSH
+  MAX7456_WriteString("PUSH", DEBUGDPOSPUSH);
+  itoa(pushtime, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSPUSH + 5);
+#endif
+#if defined DEBUGDPOSOVERLAP && defined MAX7456_LOOP_DRAW
+  MAX7456_WriteString("OVL", DEBUGDPOSOVERLAP);
+  itoa(overlaprate, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSOVERLAP + 4);
+#endif
+#if defined DEBUGDPOSFIELD && defined USE_VSYNC
+  MAX7456_WriteString("FLD", DEBUGDPOSFIELD);
+  itoa(fieldbytes, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSFIELD + 4);
+  itoa(framefields > 9 ? 9 : framefields, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSFIELD + 8);
+#endif
+#ifdef DEBUGDPOSDECODE
+  MAX7456_WriteString("DEC", DEBUGDPOSDECODE);
+  itoa(decodetime, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSDECODE + 4);
+#endif
+#if defined DEBUGDPOSMSPRX && defined MSP_RX_ISR
+  MAX7456_WriteString("OVF", DEBUGDPOSMSPRX);
+  itoa(Serial.overflow, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRX + 4);
+  MAX7456_WriteString("DRP", DEBUGDPOSMSPRX + LINE);
+  itoa(Serial.dropped, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRX + LINE + 4);
+#endif
+#if defined DEBUGDPOSMSPRX && defined SERIAL_RX_RING
+  MAX7456_WriteString("OVF", DEBUGDPOSMSPRX);
+  itoa(Serial.overflow, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRX + 4);
+  MAX7456_WriteString("FE", DEBUGDPOSMSPRX + LINE);
+  itoa(Serial.framing, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRX + LINE + 4);
+#endif
+#if defined DEBUGDPOSMSPSCHED && defined MSP_SCHEDULER
+  MAX7456_WriteString("SCH", DEBUGDPOSMSPSCHED);
+  for (uint8_t i = 0; i < MSP_SCHED_ENTRIES; i++) {
+    itoa(mspSchedRate[i] > 99 ? 99 : mspSchedRate[i], screenBuffer, 10);
+    MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPSCHED + 4 + (i * 3));
+  }
+#endif
+#if defined DEBUGDPOSMSPRTT && defined MSP_PIPELINE
+  MAX7456_WriteString("RTT", DEBUGDPOSMSPRTT);
+  itoa(msprtt > 999 ? 999 : msprtt, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRTT + 4);
+  MAX7456_WriteString("RPL", DEBUGDPOSMSPRTT + 8);
+  itoa(mspreplyrate > 999 ? 999 : mspreplyrate, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRTT + 12);
+  MAX7456_WriteString("TMO", DEBUGDPOSMSPRTT + 16);
+  itoa(msptimeoutrate > 999 ? 999 : msptimeoutrate, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMSPRTT + 20);
+#endif
+#if defined DEBUGDPOSBAUD && defined BAUD_AUTODETECT
+  ltoa(pgm_read_dword(&baudRates[baudIndex]), screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSBAUD);
+  if (baudState != BAUD_LOCKED)
+    MAX7456_WriteString("?", DEBUGDPOSBAUD + 6);
+#endif
+#if defined DEBUGDPOSMAVSKIP && defined PROTOCOL_MAVLINK
+  MAX7456_WriteString("SK", DEBUGDPOSMAVSKIP);
+  itoa(mavskiprate > 9999 ? 9999 : mavskiprate, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMAVSKIP + 2);
+#endif
+#if defined DEBUGDPOSMAVRATE && defined MAV_ADAPTIVE_RATE
+  MAX7456_WriteString("AT", DEBUGDPOSMAVRATE);
+  itoa(MAV_ATTITUDE_RATE + mw_mav.attitudeboost, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMAVRATE + 2);
+  itoa(mavattituderate > 99 ? 99 : mavattituderate, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMAVRATE + 5);
+  MAX7456_WriteString("LD", DEBUGDPOSMAVRATE + 8);
+  itoa(mavlinkload, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMAVRATE + 10);
+  MAX7456_WriteString("B", DEBUGDPOSMAVRATE + 14);
+  itoa(mw_mav.backoff, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSMAVRATE + 15);
+#endif
+#if defined DEBUGDPOSTX && defined SERIAL_TX_QUEUE
+  MAX7456_WriteString("TX", DEBUGDPOSTX);
+  itoa(serialTxHighWater > 99 ? 99 : serialTxHighWater, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSTX + 2);
+  itoa(txdeferrate > 9999 ? 9999 : txdeferrate, screenBuffer, 10);
+  MAX7456_WriteString(screenBuffer, DEBUGDPOSTX + 5);
+#endif
+#if defined DEBUGDPOSPROTOCOL && defined PROTOCOL_AUTODETECT
+  if (protocolLocked == PROTOCOL_ID_MSP)
+    MAX7456_WriteString("MSP", DEBUGDPOSPROTOCOL);
+  else if (protocolLocked == PROTOCOL_ID_MAVLINK)
+    MAX7456_WriteString("MAV", DEBUGDPOSPROTOCOL);
+  else if (protocolLocked == PROTOCOL_ID_LTM)
+    MAX7456_WriteString("LTM", DEBUGDPOSPROTOCOL);
+  else
+    MAX7456_WriteString("---", DEBUGDPOSPROTOCOL);
+#endif
 #ifdef DEBUGDPOSMSPID
   MAX7456_WriteString("MSP ID", DEBUGDPOSMSPID);
   for (uint8_t id_row = 0; id_row <= 6; id_row++) {
@@ -2985,3 +3101,92 @@ void displayPhasers(void){
     }
 }
 
+
+
+#ifdef RENDER_LIST
+// Widgets drawn from the render list in loop display order. Each handler is
+// skipped when its layout position is hidden. Handlers that track maximums
+// or other state are marked RENDER_ALWAYS and called every frame.
+#define RENDER_ALWAYS 0xFF
+
+void displayGPSAltitude(void)
+{
+  displayAltitude(((int32_t)GPS_altitude*10),MwGPSAltPosition,SYM_GPS_ALT);
+}
+
+
+void displayBaroAltitude(void)
+{
+  displayAltitude(MwAltitude/10,MwAltitudePosition,SYM_ALT);
+}
+
+
+void displayGPSSpeed(void)
+{
+  if (!armed) 
+    GPS_speed = 0;
+  display_speed(GPS_speed, GPS_speedPosition, SYM_SPEED_GPS);
+}
+
+
+void displayAirSpeed(void)
+{
+  display_speed(AIR_speed, AIR_speedPosition, SYM_SPEED_AIR);
+}
+
+
+void displayMaxSpeed(void)
+{
+  displayItem(MAX_speedPosition, speedMAX, SYM_MAX, speedUnitAdd[Settings[S_UNITSYSTEM]], 0 );
+}
+
+
+const struct __renderitem {
+  uint8_t position;
+  void (*handler)(void);
+} renderItems[] PROGMEM = {
+  { MwHeadingGraphPosition,      displayHeadingGraph },
+  { MwHeadingPosition,           displayHeading },
+  { MwGPSAltPosition,            displayGPSAltitude },
+  { MwAltitudePosition,          displayBaroAltitude },
+  { climbratevaluePosition,      displayClimbRate },
+  { MwVarioPosition,             displayVario },
+  { GPS_numSatPosition,          displayNumberOfSat },
+  { GPS_directionToHomePosition, displayDirectionToHome },
+  { RENDER_ALWAYS,               displayDistanceToHome },   // distanceMAX
+  { TotalDistanceposition,       displayDistanceTotal },
+  { MaxDistanceposition,         displayDistanceMax },
+  { GPS_angleToHomePosition,     displayAngleToHome },
+  { DOPposition,                 displayGPSdop },
+  { RENDER_ALWAYS,               displayGPSSpeed },         // speedMAX
+  { RENDER_ALWAYS,               displayAirSpeed },         // speedMAX
+  { WIND_speedPosition,          displayWindSpeed },
+  { MAX_speedPosition,           displayMaxSpeed },
+  { MwGPSLatPositionTop,         displayGPSPosition },
+};
+
+#define RENDER_ITEMS (sizeof(renderItems) / sizeof(renderItems[0]))
+
+uint8_t renderList[RENDER_ITEMS];
+uint8_t renderCount;
+
+
+void buildRenderList(void)
+{
+  renderCount = 0;
+  for (uint8_t i = 0; i < RENDER_ITEMS; i++) {
+    uint8_t position = pgm_read_byte(&renderItems[i].position);
+    if (position == RENDER_ALWAYS || fieldIsVisible(position))
+      renderList[renderCount++] = i;
+  }
+}
+
+
+void displayRenderList(void)
+{
+  for (uint8_t i = 0; i < renderCount; i++) {
+    void (*handler)(void) = (void (*)(void))pgm_read_word(&renderItems[renderList[i]].handler);
+    handler();
+  }
+}
+#endif // RENDER_LIST
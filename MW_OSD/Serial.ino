@@ -7,6 +7,158 @@ static uint8_t readIndex;
 static uint8_t txChecksum;
 
 
+// Get distance between two points in cm
+// Get bearing from pos1 to pos2, returns an 1deg = 100 precision
+// Shared by all protocols that report GPS coordinates
+void GPS_distance_cm_bearing(int32_t* lat1, int32_t* lon1, int32_t* lat2, int32_t* lon2, uint32_t* dist, int32_t* bearing) {
+  float rads = (abs((float)*lat1) / 10000000.0) * 0.0174532925;
+  float dLat = *lat2 - *lat1;                                    // difference of latitude in 1/10 000 000 degrees
+  float dLon = (float)(*lon2 - *lon1) * cos(rads);
+  *dist = sqrt(sq(dLat) + sq(dLon)) * 1.113195;
+  *bearing = 9000.0f + atan2(-dLat, dLon) * 5729.57795f;      //Convert the output redians to 100xdeg
+  if (*bearing < 0) *bearing += 36000;
+}
+
+
+void serialBegin(uint32_t baud) {
+  Serial.begin(baud);
+#ifndef PROTOCOL_MAVLINK //use double speed asynch mode (multiwii compatible)
+  uint16_t setting = (F_CPU / 4 / baud - 1) / 2;
+  UCSR0A  |= (1 << U2X0); UBRR0H = setting >> 8; UBRR0L = setting;
+#endif
+}
+
+
+#ifdef SERIAL_TX_QUEUE
+// True if len bytes fit in the transmit buffer without waiting. Writers
+// that get false try again later
+uint8_t serialTxReady(uint8_t len) {
+  uint8_t room = Serial.availableForWrite();
+  if (room < len) {
+#ifdef DEBUGDPOSTX
+    timer.txdeferred++;
+#endif
+    return 0;
+  }
+  uint8_t used = SERIAL_TX_ROOM - room + len;
+  if (used > serialTxHighWater)
+    serialTxHighWater = used;
+  return 1;
+}
+#endif // SERIAL_TX_QUEUE
+
+
+#ifdef SERIAL_FRAME_HOOK
+// Called by each decoder for every frame with a valid checksum. id is
+// PROTOCOL_ID_NONE for GUI frames
+void serialFrame(uint8_t id) {
+#ifdef BAUD_AUTODETECT
+  if (baudFrames < 255)
+    baudFrames++;
+#endif
+#ifdef PROTOCOL_AUTODETECT
+  if (id == PROTOCOL_ID_NONE)
+    return;
+  if (protocolLocked == id) {
+    protocolLastFrame = millis();
+    return;
+  }
+  if (protocolLocked != PROTOCOL_ID_NONE)
+    return;
+  if (protocolCandidate != id) {
+    protocolCandidate = id;
+    protocolFrames = 0;
+  }
+  if (++protocolFrames >= PROTOCOL_LOCK_FRAMES) {
+    protocolLocked = id;
+    protocolLastFrame = millis();
+  }
+#endif
+}
+#endif // SERIAL_FRAME_HOOK
+
+
+#ifdef PROTOCOL_AUTODETECT
+// Searches again once the locked protocol stops
+void protocolCheck(void) {
+  if (protocolLocked != PROTOCOL_ID_NONE && (uint16_t)((uint16_t)millis() - protocolLastFrame) > PROTOCOL_LOCK_TIMEOUT) {
+    protocolLocked = PROTOCOL_ID_NONE;
+    protocolCandidate = PROTOCOL_ID_NONE;
+    protocolFrames = 0;
+  }
+}
+#endif // PROTOCOL_AUTODETECT
+
+
+#ifdef BAUD_AUTODETECT
+void baudSelect(uint8_t index) {
+  baudIndex = index;
+  Serial.flush();
+  serialBegin(pgm_read_dword(&baudRates[index]));
+}
+
+
+// Starts on the rate saved by the last scan, or BAUDRATE
+void baudInit(void) {
+  uint8_t saved = EEPROM.read(BAUD_EEPROM);
+  uint8_t index = 0;
+  if ((saved & 0xF0) == BAUD_EEPROM_MAGIC && (saved & 0x0F) < BAUD_RATES)
+    index = saved & 0x0F;
+  else {
+    for (uint8_t i = 0; i < BAUD_RATES; i++) {
+      if (pgm_read_dword(&baudRates[i]) == BAUDRATE)
+        index = i;
+    }
+  }
+  baudState = BAUD_VERIFY;
+  baudSelect(index);
+}
+
+
+// Called once per second. Scores each rate by the valid frames received in
+// one second and keeps the best. Scans again once frames stop
+void baudCheck(void) {
+  uint8_t frames = baudFrames;
+  baudFrames = 0;
+  if (baudState == BAUD_LOCKED) {
+    if (frames)
+      baudIdle = 0;
+    else if (++baudIdle >= BAUD_LOST_TIME)
+      baudState = BAUD_VERIFY;
+    return;
+  }
+  if (baudState == BAUD_VERIFY) {
+    if (frames) {
+      baudState = BAUD_LOCKED;
+      baudIdle = 0;
+      return;
+    }
+    baudState = BAUD_SCAN;
+    baudBestFrames = 0;
+    baudSelect(0);
+    return;
+  }
+  if (frames > baudBestFrames) {
+    baudBest = baudIndex;
+    baudBestFrames = frames;
+  }
+  if (baudIndex + 1 < BAUD_RATES) {
+    baudSelect(baudIndex + 1);
+    return;
+  }
+  if (baudBestFrames == 0) {                 // Nothing found. Scan again
+    baudSelect(0);
+    return;
+  }
+  baudState = BAUD_LOCKED;
+  baudIdle = 0;
+  baudSelect(baudBest);
+  if (EEPROM.read(BAUD_EEPROM) != (BAUD_EEPROM_MAGIC | baudBest))
+    EEPROM.write(BAUD_EEPROM, BAUD_EEPROM_MAGIC | baudBest);
+}
+#endif // BAUD_AUTODETECT
+
+
 #if defined PROTOCOL_LTM
   #include "LTM.h"
 #endif 
@@ -91,15 +243,7 @@ void mspV2WriteRequest(uint16_t mspCommand, uint8_t txDataSize){
 
 void mspV2Write8(uint8_t a){
   Serial.write(a);
-  txChecksum ^= a;
-  for (int ii = 0; ii < 8; ++ii){
-    if (txChecksum & 0x80){
-      txChecksum = (txChecksum << 1) ^ 0xD5;
-    }
-    else{
-      txChecksum = txChecksum << 1;
-    }
-  }
+  txChecksum = crc8_dvb_s2_update(txChecksum, a);
 }
 
 void mspV2Write16(uint16_t t){
@@ -107,22 +251,6 @@ void mspV2Write16(uint16_t t){
   mspV2Write8(t>>8);
 }
 
-void crc8_dvb_s2_tx(uint8_t crc, unsigned char a, uint8_t crcversion)
-{
-  crc ^= a;
-  if (crcversion == 2){   
-    for (int ii = 0; ii < 8; ++ii){
-      if (crc & 0x80){
-        crc = (crc << 1) ^ 0xD5;
-      }
-      else{
-        crc = crc << 1;
-      }
-    }
-  }
-    txChecksum=crc;
-}
-
 // Writes to GUI (OSD_xxx) is distinguished from writes to FC (MSP_xxx) by
 // cfgWrite*() and mspWrite*().
 //
@@ -243,6 +371,189 @@ void serialKISSrequest(uint8_t request) {
 }
 #endif
 
+#ifdef PROTOCOL_MSP
+// --------------------------------------------------------------------------------------
+// Fixed layout replies are decoded from descriptor tables. Each field is copied
+// little endian from its payload offset and zero extended to the destination,
+// as read8/16/32 would. Fields beyond a short payload keep their last value.
+// Decode cost is fixed per message: one table lookup and a copy per field.
+
+struct __mspfield {
+  uint8_t offset;
+  uint8_t size;                     // Payload bytes in low nibble, destination bytes in high nibble
+  void *dest;
+};
+
+#define MSP_FIELD(offset, width, var) { offset, (sizeof(var) << 4) | width, &(var) }
+
+struct __mspdecoder {
+  const struct __mspfield *fields;
+  uint8_t count;
+  void (*decoded)(void);            // Called after the fields are copied
+};
+
+#define MSP_FIELDS(table) table, sizeof(table) / sizeof(table[0])
+
+void mspStatusDecoded(void)
+{
+#if defined FORCESENSORS
+  MwSensorPresent|=BAROMETER|MAGNETOMETER|ACCELEROMETER;
+#endif  
+  armed = (MwSensorActive & mode.armed) != 0;
+  if (!configMode){
+    CurrentFCProfile=FCProfile;
+    PreviousFCProfile=FCProfile;
+  }
+}
+
+void mspRawGPSDecoded(void)
+{
+#ifdef ALARM_GPS
+  timer.GPS_active=ALARM_GPS;
+#endif //ALARM_GPS
+  if (serialBuffer[0]){
+    GPS_fix=1;
+  }
+  // Fields missing from a short payload still hold the adjusted value
+#if defined RESETGPSALTITUDEATARM
+  if (dataSize >= 12) {
+    if (!armed){
+      GPS_home_altitude=GPS_altitude;
+      MSP_home_set=1;
+    } 
+    GPS_altitude=GPS_altitude-GPS_home_altitude;
+  }
+#endif // RESETGPSALTITUDEATARM  
+#if defined I2CGPS_SPEED
+  if (dataSize >= 14)
+    GPS_speed*=10;
+  //gpsfix(); untested
+#endif // I2CGPS_SPEED
+#ifndef MSPV2
+  AIR_speed=GPS_speed;
+#endif  
+}
+
+void mspAttitudeDecoded(void)
+{
+#if defined (AUTOSENSEMAG) && defined (FIXEDWING)     
+  if(!(MwSensorPresent&MAGNETOMETER))
+    MwHeading = GPS_ground_course/10;
+#elif defined (FIXEDWING)
+  if (Settings[S_USEGPSHEADING]>0)
+    MwHeading = GPS_ground_course/10;
+#endif
+#ifdef HEADINGCORRECT
+  if (MwHeading >= 180) MwHeading -= 360;
+#endif
+}
+
+void mspAnalogDecoded(void)
+{
+  if(!Settings[S_MWAMPERAGE]) {
+    pMeterSum=0;
+  }
+}
+
+const struct __mspfield mspStatusFields[] PROGMEM = {
+  MSP_FIELD(0, 2, cycleTime),
+  MSP_FIELD(2, 2, I2CError),
+  MSP_FIELD(4, 2, MwSensorPresent),
+  MSP_FIELD(6, 4, MwSensorActive),
+  MSP_FIELD(10, 1, FCProfile),
+};
+
+const struct __mspfield mspRawGPSFields[] PROGMEM = {
+  MSP_FIELD(1, 1, GPS_numSat),
+  MSP_FIELD(2, 4, GPS_latitude),
+  MSP_FIELD(6, 4, GPS_longitude),
+  MSP_FIELD(10, 2, GPS_altitude),
+  MSP_FIELD(12, 2, GPS_speed),
+  MSP_FIELD(14, 2, GPS_ground_course),
+#if defined MSP_DOP_SUPPORT
+  MSP_FIELD(16, 2, GPS_dop),
+#endif
+};
+
+const struct __mspfield mspCompGPSFields[] PROGMEM = {
+  MSP_FIELD(0, 2, GPS_distanceToHome),
+  MSP_FIELD(2, 2, GPS_directionToHome),
+#if defined GPSTIME && !defined MSP_RTC_SUPPORT
+  MSP_FIELD(5, 4, GPS_time),
+#endif
+};
+
+const struct __mspfield mspAttitudeFields[] PROGMEM = {
+  MSP_FIELD(0, 2, MwAngle[0]),
+  MSP_FIELD(2, 2, MwAngle[1]),
+  MSP_FIELD(4, 2, MwHeading),
+};
+
+const struct __mspfield mspAnalogFields[] PROGMEM = {
+  MSP_FIELD(0, 1, MwVBat),
+  MSP_FIELD(1, 2, pMeterSum),
+#ifdef DUALRSSI
+  MSP_FIELD(3, 2, FCRssi),
+#else
+  MSP_FIELD(3, 2, MwRssi),
+#endif      
+  MSP_FIELD(5, 2, MWAmperage),
+};
+
+// Indexed by cmdMSP - MSP_STATUS
+const struct __mspdecoder mspDecoders[] PROGMEM = {
+  { MSP_FIELDS(mspStatusFields), mspStatusDecoded },     // MSP_STATUS
+  { NULL, 0, NULL },                                     // MSP_RAW_IMU
+  { NULL, 0, NULL },                                     // MSP_SERVO
+  { NULL, 0, NULL },                                     // MSP_MOTOR
+  { NULL, 0, NULL },                                     // MSP_RC
+  { MSP_FIELDS(mspRawGPSFields), mspRawGPSDecoded },     // MSP_RAW_GPS
+#ifdef I2CGPS_DISTANCE
+  { MSP_FIELDS(mspCompGPSFields), gpsdistancefix },      // MSP_COMP_GPS
+#else
+  { MSP_FIELDS(mspCompGPSFields), NULL },                // MSP_COMP_GPS
+#endif
+  { MSP_FIELDS(mspAttitudeFields), mspAttitudeDecoded }, // MSP_ATTITUDE
+  { NULL, 0, NULL },                                     // MSP_ALTITUDE
+  { MSP_FIELDS(mspAnalogFields), mspAnalogDecoded },     // MSP_ANALOG
+};
+
+#define MSP_DECODERS (sizeof(mspDecoders) / sizeof(mspDecoders[0]))
+
+// Returns 0 if cmdMSP has no descriptor table
+uint8_t mspDecode(void)
+{
+  if (cmdMSP < MSP_STATUS || cmdMSP >= MSP_STATUS + MSP_DECODERS)
+    return 0;
+  const struct __mspdecoder *decoder = &mspDecoders[cmdMSP - MSP_STATUS];
+  uint8_t count = pgm_read_byte(&decoder->count);
+  if (count == 0)
+    return 0;
+#ifdef DEBUGDPOSDECODE
+  uint16_t start = micros();
+#endif
+  const struct __mspfield *field = (const struct __mspfield *)pgm_read_word(&decoder->fields);
+  for (; count > 0; count--, field++) {
+    uint8_t offset = pgm_read_byte(&field->offset);
+    uint8_t size = pgm_read_byte(&field->size);
+    uint8_t *dest = (uint8_t *)pgm_read_word(&field->dest);
+    if (offset + (size & 0x0F) > dataSize)
+      continue;
+    memset(dest, 0, size >> 4);
+    memcpy(dest, serialBuffer + offset, size & 0x0F);
+  }
+  void (*decoded)(void) = (void (*)(void))pgm_read_word(&decoder->decoded);
+  if (decoded)
+    decoded();
+#ifdef DEBUGDPOSDECODE
+  uint16_t elapsed = micros() - start;
+  if (elapsed > timer.decodemax)
+    timer.decodemax = elapsed;
+#endif
+  return 1;
+}
+#endif // PROTOCOL_MSP
+
 // --------------------------------------------------------------------------------------
 // Here are decoded received commands from MultiWii
 void serialMSPCheck()
@@ -250,6 +561,12 @@ void serialMSPCheck()
   #ifdef DEBUGDPOSPACKET
     timer.packetcount++;
   #endif
+  #ifdef MSP_PIPELINE
+    mspPipelineReply(cmdMSP);
+  #endif
+  #ifdef SERIAL_FRAME_HOOK
+    serialFrame(cmdMSP == MSP_OSD ? PROTOCOL_ID_NONE : PROTOCOL_ID_MSP);
+  #endif
   readIndex = 0;
   #ifdef DATA_MSP
     timer.MSP_active=DATA_MSP; // getting something on serial port
@@ -286,7 +603,7 @@ void serialMSPCheck()
     settingswriteSerialRequest();
     }
 #ifdef GUISENSORS
-    if (cmd == OSD_SENSORS2||cmd == OSD_SENSORS) {
+    if ((cmd == OSD_SENSORS2||cmd == OSD_SENSORS) && serialTxReady((6+1+10)+(6+1+12))) { // GUI asks again if skipped
       timer.GPS_initdelay=255; 
       cfgWriteRequest(MSP_OSD,1+10);
       cfgWrite8(OSD_SENSORS);
@@ -327,11 +644,37 @@ void serialMSPCheck()
       }
       else if(dataSize == 56) {
         uint8_t c = serialBuffer[55];
-        write_NVM(c);
-        if (c==255)
-          MAX7456Setup();
+#ifdef FONT_PIPELINE
+        if (fontPipeline)
+          fontQueueChar(c);
+        else
+#endif
+        {
+          write_NVM(c);
+          if (c==255)
+            MAX7456Setup();
+        }
+      }
+    }
+#ifdef FONT_PIPELINE
+    if(cmd == OSD_FONT_PIPELINE && dataSize == 5 && !fontMode) { // Start as OSD_GET_FONT. GUI follows OSD_FONT_ACK
+      if(read16() == 7456) {
+        nextCharToRequest = read8();
+        lastCharToRequest = read8();
+        initFontMode();
+        fontPipeline = fontMode;
       }
     }
+#endif
+#ifdef FONT_SYNC
+    if(cmd == OSD_FONT_CHECKSUM && !armed) {
+      uint16_t crc = fontChecksum();
+      cfgWriteRequest(MSP_OSD,1+2);
+      cfgWrite8(OSD_FONT_CHECKSUM);
+      cfgWrite16(crc);
+      cfgWriteChecksum();
+    }
+#endif
     if(cmd == OSD_DEFAULT) {
       EEPROM.write(0, 0);
       checkEEPROM();
@@ -373,7 +716,7 @@ byte: description
 For sub-command 3 (draw string):
 2: row
 3: col
-4: attr (0=normal, 1=inverted)
+4: attr (bit 0=inverted, bit 7=blink. Blink requires EXTENDED_CHAR_ATTR)
 5...len-1: string to draw
            Zero prematurely terminates the string.
            (Charset compat problem is ignored)
@@ -401,6 +744,9 @@ For sub-command 3 (draw string):
       uint8_t canvasy = read8();
       uint8_t canvasx = read8();
       uint8_t canvasa = read8();
+#ifdef INVERTED_CHAR_SUPPORT
+      canvasa = ((canvasa & 0x01) ? MAX7456_ATTR_INV : 0) | ((canvasa & 0x80) ? MAX7456_ATTR_BLK : 0);
+#endif
       for (int i = 5; i <= dataSize ; i++) {
         char canvasc[2];
         canvasc[0] = read8();
@@ -447,22 +793,8 @@ if (cmdMSP==MSP_FC_VERSION)
   }
 #endif
 
-if (cmdMSP==MSP_STATUS)
-  {
-    cycleTime=read16();
-    I2CError=read16();
-    MwSensorPresent = read16();
-    MwSensorActive = read32();
-    #if defined FORCESENSORS
-      MwSensorPresent|=BAROMETER|MAGNETOMETER|ACCELEROMETER;
-    #endif  
-    armed = (MwSensorActive & mode.armed) != 0;
-    FCProfile = read8();
-    if (!configMode){
-      CurrentFCProfile=FCProfile;
-      PreviousFCProfile=FCProfile;
-     }
-  }
+  if (mspDecode())
+    return;
 
   if (cmdMSP==MSP_RC)
   {
@@ -473,56 +805,6 @@ if (cmdMSP==MSP_STATUS)
     handleRawRC();
   }
 
-  if (cmdMSP==MSP_RAW_GPS)
-  {
-    #ifdef ALARM_GPS
-     timer.GPS_active=ALARM_GPS;
-    #endif //ALARM_GPS
-    uint8_t GPS_fix_temp=read8();
-    if (GPS_fix_temp){
-      GPS_fix=1;
-    }
-    GPS_numSat=read8();
-    GPS_latitude = read32();
-    GPS_longitude = read32();
-    GPS_altitude = read16();
-    #if defined RESETGPSALTITUDEATARM
-      if (!armed){
-        GPS_home_altitude=GPS_altitude;
-        MSP_home_set=1;
-      } 
-      GPS_altitude=GPS_altitude-GPS_home_altitude;
-    #endif // RESETGPSALTITUDEATARM  
-    #if defined I2CGPS_SPEED
-      GPS_speed = read16()*10;
-      //gpsfix(); untested
-    #else
-      GPS_speed = read16();
-    #endif // I2CGPS_SPEED
-    #ifndef MSPV2
-      AIR_speed=GPS_speed;
-    #endif  
-    GPS_ground_course = read16();
-    #if defined MSP_DOP_SUPPORT
-      GPS_dop=read16();
-    #endif
-  }
-
-  if (cmdMSP==MSP_COMP_GPS)
-  {
-    GPS_distanceToHome=(uint32_t)read16();
-#ifdef I2CGPS_DISTANCE
-    gpsdistancefix();
-#endif
-    
-    GPS_directionToHome=read16();
-    
-#if defined GPSTIME && !defined MSP_RTC_SUPPORT
-    read8();
-    GPS_time = read32();
-#endif
-  }
-
 #if defined MULTIWII_V24
   if (cmdMSP==MSP_NAV_STATUS)
   {
@@ -533,24 +815,6 @@ if (cmdMSP==MSP_STATUS)
   }
 #endif //MULTIWII_V24 
 
-  if (cmdMSP==MSP_ATTITUDE)
-  {
-    for(uint8_t i=0;i<2;i++){
-      MwAngle[i] = read16();
-    }
-      MwHeading = read16();
-    #if defined (AUTOSENSEMAG) && defined (FIXEDWING)     
-      if(!(MwSensorPresent&MAGNETOMETER))
-        MwHeading = GPS_ground_course/10;
-    #elif defined (FIXEDWING)
-      if (Settings[S_USEGPSHEADING]>0)
-        MwHeading = GPS_ground_course/10;
-    #endif
-    #ifdef HEADINGCORRECT
-      if (MwHeading >= 180) MwHeading -= 360;
-    #endif
-  }
-
 #if defined DEBUGMW
   if (cmdMSP==MSP_DEBUG)
   {
@@ -593,21 +857,6 @@ if (cmdMSP==MSP_STATUS)
     #endif  
   }
 
-  if (cmdMSP==MSP_ANALOG)
-  {
-    MwVBat=read8();
-    pMeterSum=read16();
-    #ifdef DUALRSSI
-      FCRssi = read16();
-    #else
-      MwRssi = read16();
-    #endif      
-    MWAmperage = (int16_t)read16();
-    if(!Settings[S_MWAMPERAGE]) {
-      pMeterSum=0;
-    }
-  }
-
 #ifdef MENU_SERVO  
   if (cmdMSP==MSP_SERVO_CONF)
   {
@@ -1587,6 +1836,25 @@ void serialMenuCommon()
   }
 }
 
+#ifdef MSP_RX_ISR
+// Frames are assembled and checked in the serial interrupt. See OSDSerial.cpp
+void serialMSPreceive(uint8_t loops)
+{
+  struct __mspframe *frame;
+#ifdef DEBUGDPOSRX
+  timer.serialrxrate += Serial.rxBytes();
+#endif
+  while ((frame = Serial.frame()) != NULL) {
+    cmdMSP = frame->cmd;
+    dataSize = frame->size;
+    memcpy(serialBuffer, frame->data, dataSize);
+    Serial.frameDone();
+    serialMSPCheck();
+    if (loops == 0)
+      break;
+  }
+}
+#else
 void serialMSPreceive(uint8_t loops)
 {
   uint8_t c;
@@ -1664,9 +1932,11 @@ void serialMSPreceive(uint8_t loops)
        serialSLreceive(c);
     #endif //PROTOCOL_SKYTRACK   
     #if defined (PROTOCOL_MAVLINK)
+     if (PROTOCOL_ACTIVE(PROTOCOL_ID_MAVLINK))
        serialMAVreceive(c);
     #endif //PROTOCOL_MAVLINK   
     #if defined (PROTOCOL_LTM)
+     if (PROTOCOL_ACTIVE(PROTOCOL_ID_LTM))
        serialLTMreceive(c);
     #endif // PROTOCOL_LTM   
     #if defined (PROTOCOL_KISS)
@@ -1713,7 +1983,7 @@ void serialMSPreceive(uint8_t loops)
 
 #endif        
       rcvChecksum = 0;
-      crc8_dvb_s2(rcvChecksum,c,MSPversion);       
+      rcvChecksum = crc8_dvb_s2(rcvChecksum,c,MSPversion);       
     }
     else if (c_state == HEADER_SIZE)
     {
@@ -1730,26 +2000,26 @@ void serialMSPreceive(uint8_t loops)
       cmdMSP = c;
       c_state = PAYLOAD_READY;
 #endif        
-      crc8_dvb_s2(rcvChecksum,c,MSPversion);
+      rcvChecksum = crc8_dvb_s2(rcvChecksum,c,MSPversion);
       receiverIndex=0;
     }
     
 #ifdef MSPV2
     else if (c_state == HEADER_CMD1_MSPV2)
     {
-      crc8_dvb_s2(rcvChecksum,c, MSPversion);
+      rcvChecksum = crc8_dvb_s2(rcvChecksum,c,MSPversion);
       cmdMSP += (uint16_t)(c<<8);
       c_state = HEADER_CMD2_MSPV2;
     }
     else if (c_state == HEADER_CMD2_MSPV2)
     {
-      crc8_dvb_s2(rcvChecksum,c,MSPversion);
+      rcvChecksum = crc8_dvb_s2(rcvChecksum,c,MSPversion);
       dataSize = c;
       c_state = HEADER_SIZE1_MSPV2;
     }
     else if (c_state == HEADER_SIZE1_MSPV2)
     {
-      crc8_dvb_s2(rcvChecksum,c,MSPversion);
+      rcvChecksum = crc8_dvb_s2(rcvChecksum,c,MSPversion);
       dataSize += (uint16_t)(c<<8);
       if (dataSize > SERIALBUFFERSIZE) {  // now we are expecting the payload size
         c_state = IDLE;
@@ -1781,7 +2051,7 @@ void serialMSPreceive(uint8_t loops)
         c_state = IDLE;
       }
       else{
-        crc8_dvb_s2(rcvChecksum,c,MSPversion);
+        rcvChecksum = crc8_dvb_s2(rcvChecksum,c,MSPversion);
         serialBuffer[receiverIndex++]=c;
       }
     }
@@ -1793,24 +2063,9 @@ void serialMSPreceive(uint8_t loops)
 #endif
   }
 }
+#endif // MSP_RX_ISR
 
 
-void crc8_dvb_s2(uint8_t crc, unsigned char a, uint8_t crcversion)
-{
-  crc ^= a;
-  if (crcversion == 2){   
-    for (int ii = 0; ii < 8; ++ii){
-      if (crc & 0x80){
-        crc = (crc << 1) ^ 0xD5;
-      }
-      else{
-        crc = crc << 1;
-      }
-    }
-  }
-    rcvChecksum=crc; //  return crc;
-}
-
 #ifdef MENU_KISS
 void kissBack() {
   switch (subConfigPage) {
@@ -2006,6 +2261,23 @@ void fontSerialRequest() {
   cfgWriteChecksum();
 } 
 
+#ifdef FONT_PIPELINE
+void fontAckRequest() {
+  cfgWriteRequest(MSP_OSD,3);
+  cfgWrite8(OSD_FONT_ACK);
+  cfgWrite8(fontLastChar);
+  cfgWrite8(FONT_QUEUE - fontQueueCount);
+  cfgWriteChecksum();
+}
+
+void fontNakRequest(uint8_t cindex) {
+  cfgWriteRequest(MSP_OSD,2);
+  cfgWrite8(OSD_FONT_NAK);
+  cfgWrite8(cindex);
+  cfgWriteChecksum();
+}
+#endif
+
 void settingsSerialRequest() {
   cfgWriteRequest(MSP_OSD,1+30);
   cfgWrite8(OSD_READ_CMD_EE);
@@ -30,6 +30,8 @@ void mav_serialize32(uint32_t val) {
 void send_mavlink_ADSB_TRAFFIC_REPORT_MESSAGE(void) {
   if (GPS_numSat < MINSATFIX)
     return;
+  if (!serialTxReady(MAVLINK_MSG_ID_ADSB_TRAFFIC_REPORT_MESSAGE_LEN + 8)) // Sent again next second
+    return;
   //head:
   static int8_t tx_sequence = 0;
   tx_sequence++;
@@ -66,6 +68,8 @@ void send_mavlink_ADSB_TRAFFIC_REPORT_MESSAGE(void) {
 
 
 void send_mavlink_ADSB_STATUS_MESSAGE(void) {
+  if (!serialTxReady(MAVLINK_MSG_ID_ADSB_STATUS_LEN + 8))
+    return;
   //head:
   static int8_t tx_sequence = 0;
   tx_sequence++;
@@ -100,36 +104,6 @@ void mav_checksum(uint8_t val) {
 }
 
 
-float serialbufferfloat(uint8_t offset) {
-  float f_temp;
-  byte * b = (byte *) &f_temp;
-  for (uint8_t i = 0; i < 4; i++) {
-    b[i] = serialBuffer[offset + i];
-  }
-  return f_temp;
-}
-
-
-int32_t serialbufferint(uint8_t offset) {
-  int32_t i_temp;
-  byte * b = (byte *) &i_temp;
-  for (uint8_t i = 0; i < 4; i++) {
-    b[i] = serialBuffer[offset + i];
-  }
-  return i_temp;
-}
-
-
-void GPS_distance_cm_bearing(int32_t* lat1, int32_t* lon1, int32_t* lat2, int32_t* lon2, uint32_t* dist, int32_t* bearing) {
-  float rads = (abs((float) * lat1) / 10000000.0) * 0.0174532925;
-  float dLat = *lat2 - *lat1;                                    // difference of latitude in 1/10 000 000 degrees
-  float dLon = (float)(*lon2 - *lon1) * cos(rads);
-  *dist = sqrt(sq(dLat) + sq(dLon)) * 1.113195;
-  *bearing = 9000.0f + atan2(-dLat, dLon) * 5729.57795f;      //Convert the output redians to 100xdeg
-  if (*bearing < 0) *bearing += 36000;
-}
-
-
 void GPS_reset_home_position() {
   GPS_home[LAT] = GPS_latitude;
   GPS_home[LON] = GPS_longitude;
@@ -137,8 +111,7 @@ void GPS_reset_home_position() {
 }
 
 
-void request_mavlink_packets_PX4() {
-#define MAV_CMD_MAX 12
+void request_mavlink_packet_PX4(uint8_t i) {
   const uint8_t MavCmd[MAV_CMD_MAX] = {
     MAVLINK_MSG_ID_HEARTBEAT,
     MAVLINK_MSG_ID_VFR_HUD,
@@ -154,15 +127,26 @@ void request_mavlink_packets_PX4() {
     MAVLINK_MSG_ID_SYS_STATUS
   };
   const uint8_t MavRates[MAV_CMD_MAX] = {
-    0x01, 0x05, 0x0A, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02
+    0x01, 0x05, MAV_ATTITUDE_RATE, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02
   };
-  for (int i = 0; i < MAV_CMD_MAX; i++) {
-    request_mavlink_CMD_PX4(MavCmd[i], MavRates[i]);
-  }
+  uint8_t rate = MavRates[i];
+#ifdef MAV_ADAPTIVE_RATE
+  if (MavCmd[i] == MAVLINK_MSG_ID_ATTITUDE)
+    rate += mw_mav.attitudeboost;
+  else if (MavCmd[i] != MAVLINK_MSG_ID_HEARTBEAT)
+    rate = mavBackoff(rate);
+#endif
+#ifdef WIDGET_SUBSCRIBE
+  if ((MavCmd[i] == MAVLINK_MSG_ID_GPS_RAW_INT && !(telemetryUsed & TELEMETRY_GPS)) ||
+      (MavCmd[i] == MAVLINK_MSG_ID_ATTITUDE && !(telemetryUsed & TELEMETRY_ATTITUDE)) ||
+      (MavCmd[i] == MAVLINK_MSG_ID_WIND && !(telemetryUsed & TELEMETRY_WIND)))
+    rate = 0;
+#endif
+  request_mavlink_CMD_PX4(MavCmd[i], rate);
 }
 
 
-void request_mavlink_packets_APM() {
+void request_mavlink_packet_APM(uint8_t i) {
   const uint8_t MavStream[MAV_STREAMS] = {
     MAV_DATA_STREAM_RAW_SENSORS,
     MAV_DATA_STREAM_EXTENDED_STATUS,
@@ -173,14 +157,115 @@ void request_mavlink_packets_APM() {
     MAV_DATA_STREAM_EXTRA3
   };
   const uint16_t MavRate[MAV_STREAMS] = {
-    0x02, 0x02, 0x02, 0x02, 0x0A, 0x05, 0X02
+    0x02, 0x02, 0x02, 0x02, MAV_ATTITUDE_RATE, 0x05, 0X02
   };
-  for (int i = 0; i < MAV_STREAMS; i++) {
-    request_mavlink_CMD_APM(MavStream[i], MavRate[i]);
+  uint16_t rate = MavRate[i];
+#ifdef MAV_ADAPTIVE_RATE
+  if (MavStream[i] == MAV_DATA_STREAM_EXTRA1) // ATTITUDE
+    rate += mw_mav.attitudeboost;
+  else
+    rate = mavBackoff(rate);
+#endif
+#ifdef WIDGET_SUBSCRIBE
+  if ((MavStream[i] == MAV_DATA_STREAM_POSITION && !(telemetryUsed & TELEMETRY_GPS)) ||
+      (MavStream[i] == MAV_DATA_STREAM_EXTRA1 && !(telemetryUsed & TELEMETRY_ATTITUDE)))
+    rate = 0;
+#endif
+  request_mavlink_CMD_APM(MavStream[i], rate);
+}
+
+
+// Sends the stream requests still pending that fit in the transmit buffer.
+// Called again from loop until all are sent
+void request_mavlink_packets() {
+#ifdef PX4
+  while (mw_mav.requests && serialTxReady(MAVLINK_MSG_ID_COMMAND_LONG_LEN + 8)) {
+    request_mavlink_packet_PX4(MAV_CMD_MAX - mw_mav.requests);
+    mw_mav.requests--;
   }
+#else
+  while (mw_mav.requests && serialTxReady(MAVLINK_MSG_ID_REQUEST_DATA_STREAM_LEN + 8)) {
+    request_mavlink_packet_APM(MAV_STREAMS - mw_mav.requests);
+    mw_mav.requests--;
+  }
+#endif //PX4
+}
+
+
+#ifdef MAV_ADAPTIVE_RATE
+// Other streams slow down while the link is near full. Never below 1 Hz
+uint16_t mavBackoff(uint16_t rate) {
+  rate >>= mw_mav.backoff;
+  return rate ? rate : 1;
 }
 
 
+// Called every second. Link use is the MAVLink bytes received against the
+// serial rate. Every MAV_RATE_PERIOD seconds the attitude rate is raised a
+// step toward the video frame rate while the link has room and the FC keeps
+// up, and other streams back off before attitude is lowered when it is full
+void mavRateCheck() {
+  static uint8_t  seconds;
+  static uint32_t bytes;
+  static uint16_t attitudes;
+#ifdef BAUD_AUTODETECT
+  uint32_t capacity = pgm_read_dword(&baudRates[baudIndex]) / 10;
+#else
+  uint32_t capacity = BAUDRATE / 10;
+#endif
+
+  mavlinkload = (uint32_t)mw_mav.rxbytes * 100 / capacity;
+  mavattituderate = mw_mav.attitudes;
+  bytes += mw_mav.rxbytes;
+  attitudes += mw_mav.attitudes;
+  mw_mav.rxbytes = 0;
+  mw_mav.attitudes = 0;
+  if (++seconds < MAV_RATE_PERIOD)
+    return;
+
+  uint8_t load = bytes * 100 / (capacity * MAV_RATE_PERIOD);
+  uint8_t received = attitudes / MAV_RATE_PERIOD;
+  uint8_t requested = MAV_ATTITUDE_RATE + mw_mav.attitudeboost;
+  uint8_t change = 1;
+  seconds = 0;
+  bytes = 0;
+  attitudes = 0;
+  if (Settings[S_MAV_AUTO] == 0 || mw_mav.requests || load == 0 || !PROTOCOL_ACTIVE(PROTOCOL_ID_MAVLINK))
+    return;                       // Not requesting, previous requests still going out or no FC
+  if (load > MAV_LINK_HIGH) {
+    if (mw_mav.backoff < MAV_BACKOFF_MAX)
+      mw_mav.backoff++;
+    else if (mw_mav.attitudeboost >= MAV_ATTITUDE_STEP)
+      mw_mav.attitudeboost -= MAV_ATTITUDE_STEP;
+    else
+      change = 0;
+  }
+  else if (load < MAV_LINK_LOW) {
+    if (requested + MAV_ATTITUDE_STEP <= MAV_ATTITUDE_MAX && received >= requested * 3 / 4
+#ifdef WIDGET_SUBSCRIBE
+        && (telemetryUsed & TELEMETRY_ATTITUDE)
+#endif
+       )
+      mw_mav.attitudeboost += MAV_ATTITUDE_STEP;
+    else if (mw_mav.backoff > 0)
+      mw_mav.backoff--;
+    else
+      change = 0;
+  }
+  else
+    change = 0;
+  if (change) {
+#ifdef PX4
+    mw_mav.requests = MAV_CMD_MAX;
+#else
+    mw_mav.requests = MAV_STREAMS;
+#endif //PX4
+    request_mavlink_packets();
+  }
+}
+#endif //MAV_ADAPTIVE_RATE
+
+
 void request_mavlink_CMD_PX4(uint8_t MavCmd, uint8_t MavRate) {
   //head:
   static int8_t tx_sequence = 0;
@@ -194,7 +279,7 @@ void request_mavlink_CMD_PX4(uint8_t MavCmd, uint8_t MavRate) {
   mav_serialize8(MAVLINK_MSG_ID_COMMAND_LONG); //76
   //body:
   mav_serialize32(MavCmd); // commands - e.g. 0 = heartbeat
-  mav_serialize32(1000000 * MavRate);  // 1000000 * MavRate - interval in microsecs. 0 = default, -1 = disabled
+  mav_serialize32(MavRate ? 1000000 / MavRate : -1);  // 1000000 / MavRate - interval in microsecs. 0 = default, -1 = disabled
   mav_serialize32(0);
   mav_serialize32(0);
   mav_serialize32(0);
@@ -239,6 +324,9 @@ void serialMAVCheck() {
 #ifdef DEBUGDPOSPACKET
   timer.packetcount++;
 #endif
+#ifdef SERIAL_FRAME_HOOK
+  serialFrame(PROTOCOL_ID_MAVLINK);
+#endif
 #ifdef DATA_MSP
   timer.MSP_active = DATA_MSP; // getting valid MAV on serial port
 #endif //DATA_MSP
@@ -248,10 +336,6 @@ void serialMAVCheck() {
   uint8_t severity;
   uint8_t nullifymessage = 1;
   uint32_t t_GPS_altitude;    
-#ifdef MAV_RTC
-  uint64_t i_temp;
-  byte * b = (byte *) &i_temp;
-#endif
 
   switch (mw_mav.message_cmd) {
     case MAVLINK_MSG_ID_HEARTBEAT:
@@ -261,7 +345,7 @@ void serialMAVCheck() {
       mode.gpsmission = (1 << 6);
       MwSensorActive &= 0xFFFFFFFE; // set disarmed
 
-      mw_mav.mode = serialbufferint(0);
+      mw_mav.mode = mavPayload.heartbeat.custom_mode;
 
 #ifdef PX4
       union {
@@ -272,7 +356,7 @@ void serialMAVCheck() {
         };
         uint32_t data;
       } px4_custom_mode;
-      px4_custom_mode.data = serialbufferint(0);
+      px4_custom_mode.data = mavPayload.heartbeat.custom_mode;
       if (px4_custom_mode.main_mode == 1)
         mw_mav.mode = 0; // Manual
       else if (px4_custom_mode.main_mode == 2)
@@ -314,9 +398,9 @@ void serialMAVCheck() {
        */
 
 #ifdef ALWAYSARMED
-      serialBuffer[6] |= (1 << 7);
+      mavPayload.heartbeat.base_mode |= (1 << 7);
 #endif
-      if (serialBuffer[6] & (1 << 7)) { //armed
+      if (mavPayload.heartbeat.base_mode & (1 << 7)) { //armed
         MwSensorActive |= (1 << 0);
         armed = 1;
         armedglitchprotect = 2;
@@ -334,13 +418,21 @@ void serialMAVCheck() {
       }
       if (Settings[S_MAV_AUTO] > 0) {
         static uint8_t mavreqdone = 3;
+#ifdef WIDGET_SUBSCRIBE
+        static uint8_t mavtelemetry = 0;
+        if (mavtelemetry != telemetryUsed) { // Layout changed
+          mavtelemetry = telemetryUsed;
+          mavreqdone = 3;
+        }
+#endif
         if (mavreqdone > 0) {
 #ifndef BUDDYFLIGHT
 #ifdef PX4
-          request_mavlink_packets_PX4();
+          mw_mav.requests = MAV_CMD_MAX;
 #else
-          request_mavlink_packets_APM();
+          mw_mav.requests = MAV_STREAMS;
 #endif //PX4
+          request_mavlink_packets();
 #endif //BUDDYFLIGHT
 
           mavreqdone--;
@@ -351,19 +443,19 @@ void serialMAVCheck() {
 #ifdef DEBUGDPOSMAV
   timer.d0rate++;
 #endif    
-      AIR_speed = (int16_t)serialbufferfloat(0) * 100; // m/s-->cm/s
-      GPS_speed = (int16_t)serialbufferfloat(4) * 100; // m/s-->cm/s
-      MwHeading = serialBuffer[16] | serialBuffer[17] << 8; // deg (-->deg*10 if GPS heading)
+      AIR_speed = floatToFixed(mavPayload.vfr_hud.airspeed, FIXED_X100);    // m/s-->cm/s
+      GPS_speed = floatToFixed(mavPayload.vfr_hud.groundspeed, FIXED_X100); // m/s-->cm/s
+      MwHeading = mavPayload.vfr_hud.heading; // deg (-->deg*10 if GPS heading)
       MwHeading360 = MwHeading;
       if (MwHeading360 > 180)
         MwHeading360 = MwHeading360 - 360;
       MwHeading   = MwHeading360;
-      MwVario  = (float)serialbufferfloat(12) * 100; // m/s-->cm/s
+      MwVario  = floatToFixed(mavPayload.vfr_hud.climb, FIXED_X100); // m/s-->cm/s
       //MwVario = filter16(MwVario, t_MwVario, 4);
 
 #define USE_MAV_BARO
 #ifdef USE_MAV_BARO      
-      MwAltitude = (float) (serialbufferfloat(8) * 100);
+      MwAltitude = floatToFixed(mavPayload.vfr_hud.alt, FIXED_X100);
 #if defined RESETGPSALTITUDEATARM
       if (GPS_fix_HOME & B00000100) {
       }
@@ -376,14 +468,17 @@ void serialMAVCheck() {
       MwAltitude -= MwAltitude_home;
 #endif
  #endif //USE_MAV_GPS
-      mw_mav.throttle = (int16_t)(((serialBuffer[18] | serialBuffer[19] << 8) * 10) + 1000);
+      mw_mav.throttle = (int16_t)((mavPayload.vfr_hud.throttle * 10) + 1000);
       break;
     case MAVLINK_MSG_ID_ATTITUDE:
 #ifdef DEBUGDPOSMAV
   timer.d1rate++;
 #endif       
-      MwAngle[0] = (int16_t)(serialbufferfloat(4) * 57.2958 * 10);  // rad-->0.1deg
-      MwAngle[1] = (int16_t)(serialbufferfloat(8) * 57.2958 * -10); // rad-->0.1deg
+#ifdef MAV_ADAPTIVE_RATE
+      mw_mav.attitudes++;
+#endif
+      MwAngle[0] = floatToFixed(mavPayload.attitude.roll, FIXED_RAD_DECIDEG);   // rad-->0.1deg
+      MwAngle[1] = -floatToFixed(mavPayload.attitude.pitch, FIXED_RAD_DECIDEG);
       break;
     case MAVLINK_MSG_ID_GPS_RAW_INT:
 #ifdef DEBUGDPOSMAV
@@ -392,15 +487,15 @@ void serialMAVCheck() {
 #ifdef ALARM_GPS
       timer.GPS_active = ALARM_GPS;
 #endif //ALARM_GPS
-      GPS_numSat = serialBuffer[29];
-      GPS_fix = serialBuffer[28];
-      GPS_ground_course = (int16_t)(serialBuffer[26] | (serialBuffer[27] << 8)) / 10;
-      GPS_latitude = serialbufferint(8);
-      GPS_longitude = serialbufferint(12);
-      GPS_dop = (int16_t)(serialBuffer[20] | serialBuffer[21] << 8); 
+      GPS_numSat = mavPayload.gps_raw_int.satellites_visible;
+      GPS_fix = mavPayload.gps_raw_int.fix_type;
+      GPS_ground_course = (int16_t)mavPayload.gps_raw_int.cog / 10;
+      GPS_latitude = mavPayload.gps_raw_int.lat;
+      GPS_longitude = mavPayload.gps_raw_int.lon;
+      GPS_dop = (int16_t)mavPayload.gps_raw_int.eph; 
 #define USE_MAV_GPS
  #ifdef USE_MAV_GPS  
-      t_GPS_altitude =  (uint32_t) (serialBuffer[16] | (uint32_t)serialBuffer[17] << 8 | (uint32_t)serialBuffer[18] << 16 | (uint32_t)serialBuffer[19] << 24);    
+      t_GPS_altitude = mavPayload.gps_raw_int.alt;
       GPS_altitude = (int32_t) t_GPS_altitude / 1000; 
       #if defined RESETGPSALTITUDEATARM
 
@@ -433,11 +528,7 @@ void serialMAVCheck() {
       break;
 #ifdef MAV_RTC
     case MAVLINK_MSG_ID_SYSTEM_TIME:
-      for (uint8_t i = 0; i < 8; i++) {
-        b[i] = serialBuffer[i];
-      }
-      i_temp /= 1000000;
-      GPS_time = (uint32_t)i_temp;
+      GPS_time = (uint32_t)(mavPayload.system_time.time_unix_usec / 1000000);
       if (!armed) { // For now to avoid uneven looking clock
         setDateTime();
       }
@@ -448,14 +539,14 @@ void serialMAVCheck() {
   timer.d3rate++;
 #endif 
 #ifdef DUALRSSI
-      FCRssi = serialBuffer[21];
+      FCRssi = mavPayload.rc_channels_raw.rssi;
 #else
-      MwRssi = (uint16_t)(((102) * serialBuffer[21]) / 10);
+      MwRssi = (uint16_t)(((102) * mavPayload.rc_channels_raw.rssi) / 10);
 #endif
-      if (serialBuffer[20] != 0)
+      if (mavPayload.rc_channels_raw.port != 0)
         break;
       for (uint8_t i = 0; i < 8; i++) {
-        MwRcData[i + 1] = (int16_t)(serialBuffer[4 + (i * 2)] | (serialBuffer[5 + (i * 2)] << 8));
+        MwRcData[i + 1] = (int16_t)mavPayload.rc_channels_raw.chan_raw[i];
       }
 #if defined (TX_GUI_CONTROL)
       reverseChannels();
@@ -467,12 +558,12 @@ void serialMAVCheck() {
       break;
     case MAVLINK_MSG_ID_RC_CHANNELS:
 #ifdef DUALRSSI
-      FCRssi = serialBuffer[41];
+      FCRssi = mavPayload.rc_channels.rssi;
 #else
-      MwRssi = (uint16_t)(((102) * serialBuffer[41]) / 10);
+      MwRssi = (uint16_t)(((102) * mavPayload.rc_channels.rssi) / 10);
 #endif
       for (uint8_t i = 0; i < TX_CHANNELS; i++)
-        MwRcData[i + 1] = (int16_t)(serialBuffer[4 + (i * 2)] | (serialBuffer[5 + (i * 2)] << 8));
+        MwRcData[i + 1] = (int16_t)mavPayload.rc_channels.chan_raw[i];
 #if defined (TX_GUI_CONTROL)
       reverseChannels();
 #endif // TX_PRYT
@@ -483,8 +574,8 @@ void serialMAVCheck() {
       handleRawRC();
       break;
     case MAVLINK_MSG_ID_WIND:
-      WIND_direction = (int16_t)(360 + MwHeading - serialbufferfloat(0)) % 360;
-      WIND_speed     = serialbufferfloat(4) * 3.6; // m/s=>km/h
+      WIND_direction = (int16_t)(360 + MwHeading - floatToFixed(mavPayload.wind.direction, FIXED_X1)) % 360;
+      WIND_speed     = floatToFixed(mavPayload.wind.speed, FIXED_MS_KMH); // m/s=>km/h
       break;
 #ifdef MAV_STATUS
     case  MAVLINK_MSG_ID_STATUSTEXT:
@@ -520,12 +611,12 @@ void serialMAVCheck() {
 
 #ifdef MAVSENSOR132
     case  MAVLINK_MESSAGE_INFO_DISTANCE_SENSOR:
-      MAV_altitude = serialbufferint(8);
+      MAV_altitude = mavPayload.distance_sensor.current_distance;
       break;
 #endif
 #ifdef MAVSENSOR173
     case  MAVLINK_MSG_ID_RANGEFINDER:
-      MAV_altitude = (float)100 * serialbufferfloat(0);
+      MAV_altitude = (float)100 * mavPayload.rangefinder.distance;
       break;
 #endif
 
@@ -539,11 +630,11 @@ void serialMAVCheck() {
     */
     case MAVLINK_MSG_ID_SCALED_PRESSURE:
     case MAVLINK_MSG_ID_SCALED_PRESSURE2:
-      temperature = (int16_t)serialbufferint(12) / 100;
+      temperature = mavPayload.scaled_pressure.temperature / 100;
       break;
 #ifdef MAV_VBAT2
     case MAVLINK_MSG_ID_BATTERY2:
-      MwVBat2 = (int16_t)serialbufferint(0) / 100;
+      MwVBat2 = (int16_t)mavPayload.battery2.voltage / 100;
       break;
 #endif
 #ifdef MAV_ADSB
@@ -566,19 +657,18 @@ void serialMAVCheck() {
       uint8_t t_update;      
       if (GPS_numSat < 5)
         break;
-      readIndex=0;  
-      t_icao = read32();
-      t_lat = read32();
-      t_lon = read32();
-      t_alt = read32() / 1000;
-      t_cog = read16() / 100;
+      t_icao = mavPayload.adsb_vehicle.icao_address;
+      t_lat = mavPayload.adsb_vehicle.lat;
+      t_lon = mavPayload.adsb_vehicle.lon;
+      t_alt = mavPayload.adsb_vehicle.altitude / 1000;
+      t_cog = mavPayload.adsb_vehicle.heading / 100;
       GPS_distance_cm_bearing(&GPS_latitude, &GPS_longitude, &t_lat, &t_lon, &t_dist, &t_dir);
       t_dist/=100;
       t_dir/=100;
 
 #ifdef ADSBSTATION
       int16_t  t_hvel;
-      t_hvel = read16() / 100;      
+      t_hvel = mavPayload.adsb_vehicle.hor_velocity / 100;
       ADSBSlist(t_icao, t_dist, t_alt, t_cog, t_hvel);
 #endif      
       t_update = 1;
@@ -609,10 +699,10 @@ void serialMAVCheck() {
       break;
 #endif
     case MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT:
-      GPS_waypoint_dist = (int16_t)(serialBuffer[24]) | (serialBuffer[25] << 8);
+      GPS_waypoint_dist = (int16_t)mavPayload.nav_controller_output.wp_dist;
       break;
     case MAVLINK_MSG_ID_MISSION_CURRENT:
-      GPS_waypoint_step = (int16_t)(serialBuffer[0] | (serialBuffer[1] << 8));
+      GPS_waypoint_step = (int16_t)mavPayload.mission_current.seq;
       //GPS_waypoint_step = serialBuffer[0]; // just 256 values for now
       break;
     case MAVLINK_MSG_ID_SYS_STATUS:
@@ -620,16 +710,16 @@ void serialMAVCheck() {
       mode.baro   = (1 << 2);
       mode.mag    = (1 << 3);
       MwSensorActive &= 0xFFFFFFF1;
-      if ((serialbufferint(4) & (1 << 1)) > 0) //acc
+      if ((mavPayload.sys_status.sensors_enabled & (1 << 1)) > 0) //acc
         MwSensorActive |= (1 << 1);
-      if ((serialbufferint(4) & (1 << 3)) > 0) //baro1
+      if ((mavPayload.sys_status.sensors_enabled & (1 << 3)) > 0) //baro1
         MwSensorActive |= (1 << 2);
-      if ((serialbufferint(4) & (1 << 4)) > 0) //baro2
+      if ((mavPayload.sys_status.sensors_enabled & (1 << 4)) > 0) //baro2
         MwSensorActive |= (1 << 2);
-      if ((serialbufferint(4) & (1 << 2)) > 0) //mag
+      if ((mavPayload.sys_status.sensors_enabled & (1 << 2)) > 0) //mag
         MwSensorActive |= (1 << 3);
-      MwVBat = (uint16_t)(serialBuffer[14] | (serialBuffer[15] << 8)) / 100;
-      MWAmperage = serialBuffer[16] | (serialBuffer[17] << 8);
+      MwVBat = mavPayload.sys_status.voltage_battery / 100;
+      MWAmperage = mavPayload.sys_status.current_battery;
       break;
   }
   if (armed) {
@@ -641,221 +731,199 @@ void serialMAVCheck() {
 }
 
 
+// Finds id in mavMessages. Returns NULL if not decoded
+const struct __mavmessage *mav_message(uint8_t id)
+{
+  if (!(pgm_read_byte(&mavHandled[id >> 3]) & (1 << (id & 7))))
+    return NULL;
+  for (uint8_t i = 0; i < MAV_MESSAGES; i++) {
+    if (pgm_read_byte(&mavMessages[i].id) == id)
+      return &mavMessages[i];
+  }
+  return NULL;
+}
+
+
+// MAVLink 1 and 2 frames. MAVLink 2 payloads trimmed of trailing zeros are
+// zero extended to the MAVLink 1 length, extensions beyond the buffer are
+// checksummed but not stored. Frames not decoded or not from our system are
+// skipped by length once the header shows it
 void serialMAVreceive(uint8_t c)
 {
   static uint8_t  mav_payload_index;
   static uint16_t mav_checksum_rcv;
   static uint8_t  mav_magic = 0;
+  static uint8_t  mav_len;
+  static uint8_t  mav_v2;
+  static uint8_t  mav_signed;
+  static uint16_t mav_remaining;    // Frame bytes after this one. Header only
+  static uint16_t mav_skip;
 
   static enum _serial_state {
     MAV_IDLE,
-    MAV_HEADER_START,
     MAV_HEADER_LEN,
+    MAV_HEADER_INCOMPAT,
+    MAV_HEADER_COMPAT,
     MAV_HEADER_SEQ,
     MAV_HEADER_SYS,
     MAV_HEADER_COMP,
     MAV_HEADER_MSG,
+    MAV_HEADER_MSG1,
+    MAV_HEADER_MSG2,
     MAV_PAYLOAD,
     MAV_CHECKSUM,
+    MAV_CHECKSUM1,
+    MAV_SKIP,
   }
   mav_state = MAV_IDLE;
 
-  if ((mav_state == MAV_IDLE) || (mav_state == MAV_PAYLOAD))
+#ifdef MAV_ADAPTIVE_RATE
+  mw_mav.rxbytes++;
+#endif
+  if (mav_state == MAV_SKIP)
   {
+    if (--mav_skip == 0)
+      mav_state = MAV_IDLE;
+    return;
   }
-  else
-  {
+  if (mav_state > MAV_HEADER_LEN && mav_state < MAV_PAYLOAD)
+    mav_remaining--;
+  if (mav_state > MAV_IDLE && mav_state < MAV_CHECKSUM)
     mav_checksum(c);
-  }
 
   if (mav_state == MAV_IDLE)
   {
-    if (c == 0xFE)
+    if (c == MAVLINK_STX_V1 || c == MAVLINK_STX_V2)
     {
+      mav_v2 = (c == MAVLINK_STX_V2);
       mw_mav.serial_checksum = 0xFFFF;
       mav_payload_index = 0;
-      mav_state = MAV_HEADER_START;
-    }
-    else
-    {
-      mav_state = MAV_IDLE;
+      mav_state = MAV_HEADER_LEN;
     }
   }
-  else if (mav_state == MAV_HEADER_START)
+  else if (mav_state == MAV_HEADER_LEN)
   {
     mw_mav.message_length = c;
-    if (c >= SERIALBUFFERSIZE) {
+    mav_remaining = c + (mav_v2 ? 10 : 6);
+    if (mav_v2) {
+      mav_state = MAV_HEADER_INCOMPAT;
+    }
+    else if (c >= SERIALBUFFERSIZE) { // Too long to decode. Skipped so payload bytes are not taken as STX
+      mav_state = MAV_SKIP;
+    }
+    else {
+      mav_state = MAV_HEADER_SEQ;
+    }
+  }
+  else if (mav_state == MAV_HEADER_INCOMPAT)
+  {
+    mav_signed = c & MAVLINK_IFLAG_SIGNED;
+    if (mav_signed)
+      mav_remaining += MAVLINK_SIGNATURE_LEN;
+    if (c & ~MAVLINK_IFLAG_SIGNED) { // Unknown incompatible feature
       mav_state = MAV_IDLE;
     }
     else {
-      mav_state = MAV_HEADER_LEN;
+      mav_state = MAV_HEADER_COMPAT;
     }
   }
-  else if (mav_state == MAV_HEADER_LEN)
+  else if (mav_state == MAV_HEADER_COMPAT)
   {
     mav_state = MAV_HEADER_SEQ;
   }
   else if (mav_state == MAV_HEADER_SEQ)
   {
-#ifdef MAV_ALL
     mav_state = MAV_HEADER_SYS;
+  }
+  else if (mav_state == MAV_HEADER_SYS)
+  {
+#ifdef MAV_ALL
+    mav_state = MAV_HEADER_COMP;
 #else
     if (c == Settings[S_MAV_SYS_ID]) {
-      mav_state = MAV_HEADER_SYS;
+      mav_state = MAV_HEADER_COMP;
     }
     else {
-      mav_state = MAV_IDLE;
+      mav_state = MAV_SKIP;
     }
 #endif
   }
-  else if (mav_state == MAV_HEADER_SYS)
+  else if (mav_state == MAV_HEADER_COMP)
   {
 #ifdef MAV_COMP_ALL
-    mav_state = MAV_HEADER_COMP;
+    mav_state = MAV_HEADER_MSG;
 #else
     if (c == MAV_COM_ID) {
-      mav_state = MAV_HEADER_COMP;
+      mav_state = MAV_HEADER_MSG;
     }
     else {
-      mav_state = MAV_IDLE;
+      mav_state = MAV_SKIP;
     }
 #endif
   }
-  else if (mav_state == MAV_HEADER_COMP)
+  else if (mav_state == MAV_HEADER_MSG)
   {
+    const struct __mavmessage *message = mav_message(c);
     mw_mav.message_cmd = c;
-    uint8_t  mav_len;
-    switch (c) {
-      case MAVLINK_MSG_ID_HEARTBEAT:
-        mav_magic = MAVLINK_MSG_ID_HEARTBEAT_MAGIC;
-        mav_len = MAVLINK_MSG_ID_HEARTBEAT_LEN;
-        break;
-      case MAVLINK_MSG_ID_VFR_HUD:
-        mav_magic = MAVLINK_MSG_ID_VFR_HUD_MAGIC;
-        mav_len = MAVLINK_MSG_ID_VFR_HUD_LEN;
-        break;
-      case MAVLINK_MSG_ID_ATTITUDE:
-        mav_magic = MAVLINK_MSG_ID_ATTITUDE_MAGIC;
-        mav_len = MAVLINK_MSG_ID_ATTITUDE_LEN;
-        break;
-      case MAVLINK_MSG_ID_GPS_RAW_INT:
-        mav_magic = MAVLINK_MSG_ID_GPS_RAW_INT_MAGIC;
-        mav_len = MAVLINK_MSG_ID_GPS_RAW_INT_LEN;
-        break;
-      case MAVLINK_MSG_ID_RC_CHANNELS_RAW:
-        mav_magic = MAVLINK_MSG_ID_RC_CHANNELS_RAW_MAGIC;
-        mav_len = MAVLINK_MSG_ID_RC_CHANNELS_RAW_LEN;
-        break;
-      case MAVLINK_MSG_ID_RC_CHANNELS:
-        mav_magic = MAVLINK_MSG_ID_RC_CHANNELS_MAGIC;
-        mav_len = MAVLINK_MSG_ID_RC_CHANNELS_LEN;
-        break;
-      case MAVLINK_MSG_ID_SYS_STATUS:
-        mav_magic = MAVLINK_MSG_ID_SYS_STATUS_MAGIC;
-        mav_len = MAVLINK_MSG_ID_SYS_STATUS_LEN;
-        break;
-      case  MAVLINK_MSG_ID_WIND:
-        mav_magic = MAVLINK_MSG_ID_WIND_MAGIC;
-        mav_len = MAVLINK_MSG_ID_WIND_LEN;
-        break;
-      case  MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT:
-        mav_magic = MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT_MAGIC;
-        mav_len = MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT_LEN;
-        break;
-      case  MAVLINK_MSG_ID_MISSION_CURRENT:
-        mav_magic = MAVLINK_MSG_ID_MISSION_CURRENT_MAGIC;
-        mav_len = MAVLINK_MSG_ID_MISSION_CURRENT_LEN;
-        break;
-      case  MAVLINK_MSG_ID_SCALED_PRESSURE:
-        mav_magic = MAVLINK_MSG_ID_SCALED_PRESSURE_MAGIC;
-        mav_len = MAVLINK_MSG_ID_SCALED_PRESSURE_LEN;
-        break;
-      case  MAVLINK_MSG_ID_SCALED_PRESSURE2:
-        mav_magic = MAVLINK_MSG_ID_SCALED_PRESSURE2_MAGIC;
-        mav_len = MAVLINK_MSG_ID_SCALED_PRESSURE2_LEN;
-        break;
-#ifdef MAV_VBAT2
-      case  MAVLINK_MSG_ID_BATTERY2:
-        mav_magic = MAVLINK_MSG_ID_BATTERY2_MAGIC;
-        mav_len = MAVLINK_MSG_ID_BATTERY2_LEN;
-        break;
-#endif
-      case  MAVLINK_MSG_ID_STATUSTEXT:
-        mav_magic = MAVLINK_MSG_ID_STATUSTEXT_MAGIC;
-        mav_len = MAVLINK_MSG_ID_STATUSTEXT_LEN;
-        break;
-#ifdef MAVSENSOR132
-      case  MAVLINK_MESSAGE_INFO_DISTANCE_SENSOR:
-        mav_magic = MAVLINK_MESSAGE_INFO_DISTANCE_SENSOR_MAGIC;
-        mav_len = MAVLINK_MESSAGE_INFO_DISTANCE_SENSOR_LEN;
-        break;
-#endif
-#ifdef MAVSENSOR173
-      case  MAVLINK_MSG_ID_RANGEFINDER:
-        mav_magic = MAVLINK_MSG_ID_RANGEFINDER_MAGIC;
-        mav_len = MAVLINK_MSG_ID_RANGEFINDER_LEN;
-        break;
-#endif
-#ifdef MAV_ADSB
-      case  MAVLINK_MSG_ID_ADSB_TRAFFIC_REPORT_MESSAGE:                       
-        mav_magic = MAVLINK_MSG_ID_ADSB_TRAFFIC_REPORT_MESSAGE_MAGIC;
-        mav_len = MAVLINK_MSG_ID_ADSB_TRAFFIC_REPORT_MESSAGE_LEN;
-        break;
-#endif
-#ifdef ADSBDEBUG
-      case  MAVLINK_MSG_ID_ADSB_STATUS:                       
-        mav_magic = MAVLINK_MSG_ID_ADSB_STATUS_MAGIC;
-        mav_len = MAVLINK_MSG_ID_ADSB_STATUS_LEN;
-        break;
-#endif
-#ifdef MAV_RTC
-      case  MAVLINK_MSG_ID_SYSTEM_TIME:
-        mav_magic = MAVLINK_MSG_ID_SYSTEM_TIME_MAGIC;
-        mav_len = MAVLINK_MSG_ID_SYSTEM_TIME_LEN;
-        break;
-#endif
-
-        /*
-              case  MAVLINK_MSG_ID_RADIO:
-                mav_magic = MAVLINK_MSG_ID_RADIO_MAGIC;
-                mav_len = MAVLINK_MSG_ID_RADIO_LEN;
-                break;
-              case  MAVLINK_MSG_ID_RADIO_STATUS:
-                mav_magic = MAVLINK_MSG_ID_RADIO_STATUS_MAGIC;
-                mav_len = MAVLINK_MSG_ID_RADIO_STATUS_LEN;
-                break;
-        */
+    mav_state = MAV_SKIP;
+    if (message != NULL) {
+      mav_magic = pgm_read_byte(&message->crcextra);
+      mav_len = pgm_read_byte(&message->len);
+      if (mav_v2)
+        mav_state = MAV_HEADER_MSG1;
+      else if (mw_mav.message_length == mav_len)
+        mav_state = MAV_PAYLOAD;
     }
-    if ((mw_mav.message_length) == mav_len) {
-      mav_state = MAV_HEADER_MSG;
+  }
+  else if (mav_state == MAV_HEADER_MSG1 || mav_state == MAV_HEADER_MSG2)
+  {
+    if (c != 0) { // 24 bit id above 255. Not decoded
+      mav_state = MAV_SKIP;
     }
-    else { // invalid length so reset check
-      mav_state = MAV_IDLE;
+    else if (mav_state == MAV_HEADER_MSG1) {
+      mav_state = MAV_HEADER_MSG2;
+    }
+    else {
+      mav_state = mw_mav.message_length ? MAV_PAYLOAD : MAV_CHECKSUM;
     }
   }
-  else if (mav_state == MAV_HEADER_MSG)
+  else if (mav_state == MAV_PAYLOAD)
   {
-    serialBuffer[mav_payload_index] = c;
+    if (mav_payload_index < SERIALBUFFERSIZE)
+      serialBuffer[mav_payload_index] = c;
     mav_payload_index++;
     if (mav_payload_index == mw_mav.message_length) { // end of data
-      mav_state = MAV_PAYLOAD;
+      mav_state = MAV_CHECKSUM;
     }
   }
-  else if (mav_state == MAV_PAYLOAD)
+  else if (mav_state == MAV_CHECKSUM)
   {
-    if (mav_payload_index == mw_mav.message_length) {
-      mav_checksum_rcv = c;
-      mav_payload_index++;
+    mav_checksum_rcv = c;
+    mav_state = MAV_CHECKSUM1;
+  }
+  else if (mav_state == MAV_CHECKSUM1)
+  {
+    mav_checksum_rcv += (c << 8);
+    mav_checksum(mav_magic);
+    if (mav_checksum_rcv == mw_mav.serial_checksum) {
+      for (; mav_payload_index < mav_len; mav_payload_index++) // trimmed MAVLink 2 payload
+        serialBuffer[mav_payload_index] = 0;
+      serialMAVCheck();
     }
-    else {
-      mav_checksum_rcv += (c << 8);
-      mav_checksum(mav_magic);
-      if (mav_checksum_rcv == mw_mav.serial_checksum) {
-        serialMAVCheck();
-      }
-      mav_state = MAV_IDLE;
+    mav_state = MAV_IDLE;
+    if (mav_v2 && mav_signed) {
+      mav_skip = MAVLINK_SIGNATURE_LEN;
+      mav_state = MAV_SKIP;
     }
   }
+
+  if (mav_state == MAV_SKIP && mav_skip == 0) // Rest of the frame from the header
+  {
+    mav_skip = mav_remaining;
+#ifdef DEBUGDPOSMAVSKIP
+    timer.mavskipped += mav_remaining;
+#endif
+  }
 }
 
 #endif
@@ -0,0 +1,23 @@
+/*
+  crc8.h
+
+  CRC8 DVB-S2 (polynomial 0xD5) as used by MSPv2. Table driven, one byte at
+  a time. Start with crc 0 and pass the returned crc with the next byte.
+*/
+
+#ifndef CRC8_H
+#define CRC8_H
+
+#include <stdint.h>
+
+uint8_t crc8_dvb_s2_update(uint8_t crc, uint8_t a);
+
+// MSPv1 uses a plain XOR checksum, MSPv2 the CRC
+static inline uint8_t crc8_dvb_s2(uint8_t crc, uint8_t a, uint8_t crcversion)
+{
+  if (crcversion == 2)
+    return crc8_dvb_s2_update(crc, a);
+  return crc ^ a;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+  fixed.cpp
+
+  Float to fixed point conversion. See fixed.h
+*/
+
+#include "fixed.h"
+
+int32_t floatToFixed(float f, uint16_t mult, uint8_t shift)
+{
+  union {
+    float    f;
+    uint32_t u;
+  } v;
+  v.f = f;
+
+  uint8_t exponent = v.u >> 23;
+  if (exponent == 0)                            // Zero or denormal
+    return 0;
+  // |f| = m / 2^15 * 2^(exponent - 127) with m the top 16 mantissa bits
+  uint16_t m = (uint16_t)(v.u >> 8) | 0x8000;
+  int16_t right = (int16_t)(127 + 15 + shift) - exponent;
+  if (right >= 32)
+    return 0;
+  if (right <= 0)                               // Too large, infinity or NaN
+    return (v.u & 0x80000000UL) ? -0x7FFFFFFFL : 0x7FFFFFFFL;
+
+  uint32_t p = (uint32_t)m * mult;
+  if (right >= 16) {                            // Byte moves on the AVR
+    p >>= 16;
+    right -= 16;
+  }
+  if (right >= 8) {
+    p >>= 8;
+    right -= 8;
+  }
+  p >>= right;                                  // Shifted 1 bit or more in total and m * mult < 2^32, so p < 2^31
+  return (v.u & 0x80000000UL) ? -(int32_t)p : (int32_t)p;
+}
@@ -0,0 +1,26 @@
+/*
+  fixed.h
+
+  Float to fixed point conversion on the IEEE-754 bits, for MAVLink float
+  fields. The AVR has no FPU, so f * scale as float costs a soft float
+  multiply and a conversion. This costs one 16x16 bit multiply and a shift.
+*/
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+// scale as a 16 bit multiplier for floatToFixed. Pick shift so the result is
+// 32768..65535, which keeps 16 significant bits
+#define FIXED_SCALE(scale, shift) ((uint16_t)((scale) * (1UL << (shift)) + 0.5))
+
+#define FIXED_RAD_DECIDEG FIXED_SCALE(572.957795, 6), 6 // rad-->0.1deg
+#define FIXED_X100        FIXED_SCALE(100.0, 9), 9      // m/s-->cm/s, m-->cm
+#define FIXED_MS_KMH      FIXED_SCALE(3.6, 14), 14      // m/s-->km/h
+#define FIXED_X1          FIXED_SCALE(1.0, 15), 15
+
+// f * mult / 2^shift, truncated toward zero. Saturates beyond 31 bits
+int32_t floatToFixed(float f, uint16_t mult, uint8_t shift);
+
+#endif
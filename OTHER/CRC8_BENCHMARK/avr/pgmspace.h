@@ -0,0 +1,11 @@
+// Host stand in for avr/pgmspace.h. Flash reads are plain loads.
+
+#ifndef PGMSPACE_HOST_H
+#define PGMSPACE_HOST_H
+
+#include <stdint.h>
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+
+#endif
@@ -0,0 +1,90 @@
+// Host benchmark of the MSPv2 CRC8 DVB-S2 implementations.
+// Compares the firmware 256 byte table and 16 byte nibble table from
+// MW_OSD/crc8.cpp against the previous 8 step shift loop. Checks all three
+// agree for every crc and byte, then reports cycles per byte.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+uint8_t crc8_table_update(uint8_t crc, uint8_t a);
+uint8_t crc8_nibble_update(uint8_t crc, uint8_t a);
+
+// Previous firmware implementation
+__attribute__((noinline)) uint8_t crc8_loop_update(uint8_t crc, uint8_t a)
+{
+  crc ^= a;
+  for (int ii = 0; ii < 8; ++ii) {
+    if (crc & 0x80)
+      crc = (crc << 1) ^ 0xD5;
+    else
+      crc = crc << 1;
+  }
+  return crc;
+}
+
+#define BUFFER_SIZE 4096
+#define PASSES      2000
+
+static uint8_t buffer[BUFFER_SIZE];
+
+static uint64_t now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+static void bench(const char *name, uint8_t (*update)(uint8_t, uint8_t))
+{
+  uint8_t crc = 0;
+  uint64_t best = UINT64_MAX;
+  for (int pass = 0; pass < PASSES; pass++) {
+    uint64_t start = now();
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+      crc = update(crc, buffer[i]);
+    uint64_t elapsed = now() - start;
+    if (elapsed < best)
+      best = elapsed;
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  printf("%-8s %6.2f cycles/byte (crc %02x)\n", name, (double)best / BUFFER_SIZE, crc);
+#else
+  printf("%-8s %6.2f ns/byte (crc %02x)\n", name, (double)best / BUFFER_SIZE, crc);
+#endif
+}
+
+int main(void)
+{
+  for (unsigned crc = 0; crc < 256; crc++) {
+    for (unsigned a = 0; a < 256; a++) {
+      uint8_t expect = crc8_loop_update(crc, a);
+      if (crc8_table_update(crc, a) != expect || crc8_nibble_update(crc, a) != expect) {
+        printf("mismatch crc %02x byte %02x\n", crc, a);
+        return 1;
+      }
+    }
+  }
+  uint8_t check = 0;
+  for (const char *p = "123456789"; *p; p++)
+    check = crc8_table_update(check, *p);
+  printf("check \"123456789\": %02x %s\n", check, check == 0xbc ? "ok" : "FAIL");
+  if (check != 0xbc)
+    return 1;
+
+  srand(1);
+  for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+    buffer[i] = rand();
+  bench("loop", crc8_loop_update);
+  bench("nibble", crc8_nibble_update);
+  bench("table", crc8_table_update);
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Host benchmark of the MAVLink float to fixed point conversion.
+// Compares floatToFixed() from MW_OSD/fixed.cpp with the float multiplies
+// serialMAVCheck() used before for ATTITUDE, VFR_HUD and WIND. Reports the
+// largest difference over each field's range, then cycles per conversion.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "fixed.h"
+
+// Previous firmware conversions
+__attribute__((noinline)) int32_t float_rad_decideg(float f) { return (int16_t)(f * 57.2958 * 10); }
+__attribute__((noinline)) int32_t float_x100(float f)        { return (int16_t)(f * 100); }
+__attribute__((noinline)) int32_t float_ms_kmh(float f)      { return (uint16_t)(f * 3.6); }
+
+__attribute__((noinline)) int32_t fixed_rad_decideg(float f) { return floatToFixed(f, FIXED_RAD_DECIDEG); }
+__attribute__((noinline)) int32_t fixed_x100(float f)        { return floatToFixed(f, FIXED_X100); }
+__attribute__((noinline)) int32_t fixed_ms_kmh(float f)      { return floatToFixed(f, FIXED_MS_KMH); }
+
+#define BUFFER_SIZE 4096
+#define PASSES      2000
+
+static float buffer[BUFFER_SIZE];
+
+static uint64_t now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+// Largest difference between old and new over lo..hi
+static int check(const char *name, int32_t (*old)(float), int32_t (*fixed)(float), float lo, float hi)
+{
+  int32_t worst = 0;
+  float at = 0;
+  for (int i = 0; i <= 1000000; i++) {
+    float f = lo + (hi - lo) * i / 1000000;
+    int32_t diff = labs(old(f) - fixed(f));
+    if (diff > worst) {
+      worst = diff;
+      at = f;
+    }
+  }
+  printf("%-12s %8.2f..%-8.2f max difference %d", name, lo, hi, worst);
+  if (worst)
+    printf(" at %f (%d vs %d)", at, old(at), fixed(at));
+  printf("\n");
+  return worst > 1;
+}
+
+static void bench(const char *name, int32_t (*convert)(float), float lo, float hi)
+{
+  int32_t sum = 0;
+  uint64_t best = UINT64_MAX;
+  for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+    buffer[i] = lo + (hi - lo) * rand() / RAND_MAX;
+  for (int pass = 0; pass < PASSES; pass++) {
+    uint64_t start = now();
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++)
+      sum += convert(buffer[i]);
+    uint64_t elapsed = now() - start;
+    if (elapsed < best)
+      best = elapsed;
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  printf("%-18s %6.2f cycles (sum %d)\n", name, (double)best / BUFFER_SIZE, sum);
+#else
+  printf("%-18s %6.2f ns (sum %d)\n", name, (double)best / BUFFER_SIZE, sum);
+#endif
+}
+
+int main(void)
+{
+  int fail = 0;
+  fail |= check("attitude", float_rad_decideg, fixed_rad_decideg, -3.1416, 3.1416);
+  fail |= check("speed", float_x100, fixed_x100, -100, 100);
+  fail |= check("wind", float_ms_kmh, fixed_ms_kmh, 0, 100);
+  if (floatToFixed(0.0f, FIXED_X100) != 0 || floatToFixed(1e30f, FIXED_X100) != 0x7FFFFFFF || floatToFixed(-1e30f, FIXED_X100) != -0x7FFFFFFF) {
+    printf("zero or saturation FAIL\n");
+    fail = 1;
+  }
+  if (fail)
+    return 1;
+
+  srand(1);
+  bench("float attitude", float_rad_decideg, -3.1416, 3.1416);
+  bench("fixed attitude", fixed_rad_decideg, -3.1416, 3.1416);
+  bench("float speed", float_x100, -100, 100);
+  bench("fixed speed", fixed_x100, -100, 100);
+  bench("float wind", float_ms_kmh, 0, 100);
+  bench("fixed wind", fixed_ms_kmh, 0, 100);
+  return 0;
+}
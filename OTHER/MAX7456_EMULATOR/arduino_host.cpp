@@ -0,0 +1,104 @@
+// Minimal Arduino/AVR environment for building Max7456.ino on the host.
+
+#include "arduino_host.h"
+#include "max7456.h"
+
+HostPORTD PORTD;
+uint8_t PORTB;
+uint8_t DDRB;
+uint8_t DDRD;
+HostSPDR SPDR;
+uint8_t SPCR;
+uint8_t SPSR = (1 << SPIF);
+uint8_t EIMSK;
+uint8_t EICRA;
+
+static uint32_t hostMicros;
+static uint32_t nextVSYNC = HOST_FIELD_US;
+static bool inISR;
+static bool vsyncPending;
+
+static void hostRunISR(void (*vector)(void))
+{
+  inISR = true;
+  vector();
+  inISR = false;
+}
+
+// Runs interrupts raised since the last call, as the AVR would once
+// interrupts are enabled again
+static void hostService(void)
+{
+  if (inISR)
+    return;
+  if (vsyncPending) {
+    vsyncPending = false;
+    if (INT0_vect && (EIMSK & (1 << INT0)))
+      hostRunISR(INT0_vect);
+  }
+}
+
+void hostAdvance(uint32_t us)
+{
+  hostMicros += us;
+  while ((int32_t)(hostMicros - nextVSYNC) >= 0) {
+    nextVSYNC += HOST_FIELD_US;
+    vsyncPending = true;
+  }
+  hostService();
+}
+
+uint32_t millis(void)
+{
+  hostAdvance(1);
+  return hostMicros / 1000;
+}
+
+uint32_t micros(void)
+{
+  hostAdvance(1);
+  return hostMicros;
+}
+
+void delay(uint32_t ms)
+{
+  hostAdvance(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+  hostAdvance(us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  (void)pin;
+  (void)value;
+}
+
+HostPORTD &HostPORTD::operator&=(uint8_t mask)
+{
+  out &= mask;
+  max7456.select(!(out & 0x40));
+  return *this;
+}
+
+HostPORTD &HostPORTD::operator|=(uint8_t mask)
+{
+  out |= mask;
+  max7456.select(!(out & 0x40));
+  return *this;
+}
+
+HostSPDR &HostSPDR::operator=(uint8_t data)
+{
+  in = max7456.transfer(data);
+  hostAdvance(1); // 8 bits at 8MHz
+  return *this;
+}
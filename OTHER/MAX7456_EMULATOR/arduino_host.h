@@ -0,0 +1,95 @@
+// Minimal Arduino/AVR environment for building Max7456.ino on the host.
+// SPI registers and the MAX7456 chip select are routed to the emulator.
+
+#ifndef ARDUINO_HOST_H
+#define ARDUINO_HOST_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+class MAX7456;
+extern MAX7456 max7456;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define strcpy_P strcpy
+#define strlen_P strlen
+
+#define HIGH   1
+#define LOW    0
+#define INPUT  0
+#define OUTPUT 1
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A6 20
+#define A7 21
+
+// Binary constants used by the firmware headers
+#define B00000001 0x01
+#define B00000010 0x02
+#define B00000011 0x03
+#define B00000100 0x04
+#define B00001000 0x08
+#define B00101100 0x2c
+#define B01000000 0x40
+#define B01111111 0x7f
+#define B10000000 0x80
+#define B10111111 0xbf
+#define B11011111 0xdf
+#define B11101111 0xef
+#define B11110111 0xf7
+#define B11111011 0xfb
+
+// Virtual time. Advanced by SPI bytes and by polling time
+void hostAdvance(uint32_t us);
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+// Port D bit 6 is the MAX7456 chip select on the default hardware
+struct HostPORTD {
+  HostPORTD &operator&=(uint8_t mask);
+  HostPORTD &operator|=(uint8_t mask);
+  uint8_t out;
+};
+extern HostPORTD PORTD;
+extern uint8_t PORTB;
+extern uint8_t DDRB;
+extern uint8_t DDRD;
+
+// SPI: writing SPDR clocks a byte through the emulator.
+struct HostSPDR {
+  HostSPDR &operator=(uint8_t data);
+  operator uint8_t() const { return in; }
+  uint8_t in;
+};
+extern HostSPDR SPDR;
+extern uint8_t SPCR;
+extern uint8_t SPSR;
+extern uint8_t EIMSK;
+extern uint8_t EICRA;
+enum { SPI2X = 0, MSTR = 4, SPE = 6, SPIE = 7, SPIF = 7, INT0 = 0, ISC01 = 1 };
+
+#define ISR(vector) extern "C" void vector(void)
+extern "C" void INT0_vect(void) __attribute__((weak));
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_BLOCK(type) for (uint8_t atomic_once = 1; atomic_once; atomic_once = 0)
+
+#define HOST_FIELD_US 20000 // VSYNC period. PAL
+
+#endif
@@ -0,0 +1,2 @@
+// Host stand-in for <avr/pgmspace.h>. arduino_host.h provides PROGMEM and
+// pgm_read_*
@@ -0,0 +1,204 @@
+// Host side MAX7456 emulator for MWOSD.
+// Builds the firmware Max7456.ino against an emulated MAX7456, draws screens
+// through it and renders the resulting display to PPM images. Reports the
+// SPI traffic needed for each frame.
+
+#include <stdio.h>
+#include <unistd.h>
+#include "arduino_host.h"
+#include "max7456.h"
+
+MAX7456 max7456;
+
+// Firmware configuration and MAX7456 driver
+#define MWVERS "MW-OSD - HOST"
+#define EEPROMVER 0
+#include "../../MW_OSD/Config.h"
+#include "../../MW_OSD/Def.h"
+#include "../../MW_OSD/symbols.h"
+#include "../../MW_OSD/GlobalVariables.h"
+#include "../../MW_OSD/crc8.h"
+
+void readEEPROM(void) {}
+void MAX7456_Send(uint8_t add, uint8_t data);
+void MAX7456_WriteString(const char *string, int addr);
+void MAX7456_WriteStringWithAttr(const char *string, int addr, uint8_t attr);
+void MAX7456_WaitFrame(void);
+void MAX7456_BeginFrame(void);
+void MAX7456_EndFrame(void);
+uint8_t MAX7456_PrepareNext(void);
+
+#include "../../MW_OSD/Max7456.ino"
+
+// Fonts available to preload into NVM
+namespace fontD {
+#include "../../MW_OSD/fontD.h"
+}
+namespace fontL {
+#include "../../MW_OSD/fontL.h"
+}
+namespace fontB {
+#include "../../MW_OSD/fontB.h"
+}
+
+#define GLYPH_W 12
+#define GLYPH_H 18
+
+static void usage(void)
+{
+  fprintf(stderr,
+    "usage: max7456emu [-f d|l|b] [-u] [-p] [-n] [-r count] [-o out.ppm] [screen.txt ...]\n"
+    "  -f  font loaded into NVM. Default d\n"
+    "  -u  start with empty NVM and upload the font with write_NVM\n"
+    "  -p  with -u, preload the default font so FONT_SYNC can skip matching chars\n"
+    "  -n  NTSC. Default PAL\n"
+    "  -r  draw the last screen count more times\n"
+    "  -o  write display to PPM after each frame. %%d is replaced by frame number\n"
+    "Each screen file holds up to 16 lines of up to 30 chars. Lines starting\n"
+    "with ! are drawn inverted. Without screen files a font test screen is drawn.\n");
+  exit(1);
+}
+
+static void loadScreen(const char *file)
+{
+  char line[64];
+  if (file == NULL) {
+    MAX7456_WriteString("MAX7456 EMULATOR", 37);
+    for (uint16_t x = 0; x < 255; x++)
+      screen[90 + x] = x;
+    return;
+  }
+  FILE *f = fopen(file, "r");
+  if (f == NULL) {
+    perror(file);
+    exit(1);
+  }
+  for (uint8_t row = 0; row < MAX_screen_size / LINE && fgets(line, sizeof(line), f); row++) {
+    char *text = line;
+    line[strcspn(line, "\r\n")] = 0;
+    if (strlen(text) > LINE)
+      text[LINE] = 0;
+#ifdef INVERTED_CHAR_SUPPORT
+    if (*text == '!') {
+      MAX7456_WriteStringWithAttr(text + 1, row * LINE, MAX7456_ATTR_INV);
+      continue;
+    }
+#endif
+    MAX7456_WriteString(text, row * LINE);
+  }
+  fclose(f);
+}
+
+static void renderPPM(const char *file)
+{
+  uint8_t rows = MAX_screen_size / LINE;
+  FILE *f = fopen(file, "wb");
+  if (f == NULL) {
+    perror(file);
+    exit(1);
+  }
+  fprintf(f, "P6\n%d %d\n255\n", LINE * GLYPH_W, rows * GLYPH_H);
+  for (uint16_t y = 0; y < rows * GLYPH_H; y++) {
+    for (uint16_t x = 0; x < LINE * GLYPH_W; x++) {
+      uint16_t cell = (y / GLYPH_H) * LINE + x / GLYPH_W;
+      uint8_t attr = max7456.attrs[cell];
+      uint8_t px = (y % GLYPH_H) * GLYPH_W + x % GLYPH_W;
+      uint8_t data = max7456.nvm[max7456.chars[cell]][px / 4];
+      uint8_t pixel = (data >> (6 - 2 * (px % 4))) & 3;
+      uint8_t rgb = 0x60;                 // Video
+      if (attr & 0x20)
+        rgb = 0x20;                       // Local background
+      if (pixel == 0)
+        rgb = (attr & 0x08) ? 0xff : 0x00;
+      else if (pixel == 2)
+        rgb = (attr & 0x08) ? 0x00 : 0xff;
+      putc(rgb, f);
+      putc(rgb, f);
+      putc(rgb, f);
+    }
+  }
+  fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+  const uint8_t *font = fontD::fontdata;
+  bool upload = false;
+  bool preload = false;
+  uint8_t pal = 1;
+  int repeat = 0;
+  const char *out = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "f:upnr:o:")) != -1) {
+    switch (opt) {
+    case 'f':
+      if (*optarg == 'l')
+        font = fontL::fontdata;
+      else if (*optarg == 'b')
+        font = fontB::fontdata;
+      break;
+    case 'u':
+      upload = true;
+      break;
+    case 'p':
+      preload = true;
+      break;
+    case 'n':
+      pal = 0;
+      break;
+    case 'r':
+      repeat = atoi(optarg);
+      break;
+    case 'o':
+      out = optarg;
+      break;
+    default:
+      usage();
+    }
+  }
+
+  Settings[S_VIDEOSIGNALTYPE] = pal;
+  max7456.stat = pal ? 0x01 : 0x02;
+  for (uint16_t c = 0; c < MAX7456_CHARS; c++)
+    memcpy(max7456.nvm[c], (preload ? fontD::fontdata : font) + c * MAX7456_CHAR_SIZE,
+      upload && !preload ? 0 : MAX7456_CHAR_SIZE);
+  MAX7456Setup();
+  for (uint16_t x = 0; x < MAX_screen_size; x++)
+    screen[x] = ' ';
+
+  if (upload) {
+    max7456.clearStats();
+    for (uint16_t c = 0; c < 255; c++) {
+      memcpy(serialBuffer + 1, font + c * MAX7456_CHAR_SIZE, NVM_ram_size);
+      write_NVM(c);
+    }
+    printf("font upload: %u SPI bytes, %u register writes, %u chars\n",
+      max7456.stats.spiBytes, max7456.stats.regWrites, max7456.stats.nvmWrites);
+#ifdef FONT_SYNC
+    printf("font checksum: %04x\n", fontChecksum());
+#endif
+  }
+
+  int screens = argc - optind;
+  int frames = (screens ? screens : 1) + repeat;
+  uint32_t total = 0;
+  for (int frame = 0; frame < frames; frame++) {
+    int file = frame < screens ? frame : screens - 1;
+    loadScreen(screens ? argv[optind + file] : NULL);
+    max7456.clearStats();
+    uint32_t start = micros();
+    MAX7456_DrawScreen();
+    total += max7456.stats.spiBytes;
+    printf("frame %d: %u SPI bytes, %u register writes, %u data bytes, %u chars written, %u us\n",
+      frame + 1, max7456.stats.spiBytes, max7456.stats.regWrites,
+      max7456.stats.autoIncBytes, max7456.stats.charWrites, micros() - start);
+    if (out) {
+      char name[256];
+      snprintf(name, sizeof(name), out, frame + 1);
+      renderPPM(name);
+    }
+  }
+  printf("total: %u SPI bytes in %d frames\n", total, frames);
+  return 0;
+}
@@ -0,0 +1,167 @@
+// Software model of the MAX7456 SPI interface for host side testing.
+
+#include <string.h>
+#include "max7456.h"
+
+#define REG_VM0    0x00
+#define REG_DMM    0x04
+#define REG_DMAH   0x05
+#define REG_DMAL   0x06
+#define REG_DMDI   0x07
+#define REG_CMM    0x08
+#define REG_CMAH   0x09
+#define REG_CMAL   0x0a
+#define REG_CMDI   0x0b
+#define REG_STAT   0xa0
+#define REG_DMDO   0xb0
+#define REG_CMDO   0xc0
+
+#define DMM_AUTOINC  0x01
+#define DMM_CLEAR    0x04
+#define DMM_ATTR     0x38
+#define CMM_WRITE    0xa0
+#define CMM_READ     0x50
+#define VM0_RESET    0x02
+#define END_STRING   0xff
+
+MAX7456::MAX7456()
+{
+  memset(nvm, 0, sizeof(nvm));
+  memset(shadow, 0, sizeof(shadow));
+  stat = 0x01;
+  vm0 = 0;
+  readData = 0;
+  cmah = 0;
+  cmal = 0;
+  select(false);
+  writeReg(REG_VM0, VM0_RESET);
+  clearStats();
+}
+
+void MAX7456::clearStats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+void MAX7456::select(bool low)
+{
+  cs = low;
+  pendingReg = -1;
+}
+
+uint8_t MAX7456::transfer(uint8_t data)
+{
+  if (!cs)
+    return 0xff;
+  stats.spiBytes++;
+
+  uint8_t out = readData;
+  readData = 0;
+
+  if (pendingReg >= 0) {
+    uint8_t reg = pendingReg;
+    pendingReg = -1;
+    if (!(reg & 0x80))
+      writeReg(reg, data);
+    return out;
+  }
+
+  if (autoInc) {
+    if (data == END_STRING) {
+      autoInc = false;
+      return out;
+    }
+    stats.autoIncBytes++;
+    if (dmAttrSelect)
+      attrs[dmAddr] = data;
+    else {
+      chars[dmAddr] = data;
+      attrs[dmAddr] = dmm & DMM_ATTR;
+      stats.charWrites++;
+    }
+    dmAddr = (dmAddr + 1) % MAX7456_DM_SIZE;
+    return out;
+  }
+
+  if (data & 0x80) {
+    readData = readReg(data);
+    pendingReg = data;                // Following byte is a dummy
+  } else {
+    pendingReg = data;
+  }
+  return out;
+}
+
+uint8_t MAX7456::readReg(uint8_t reg)
+{
+  switch (reg) {
+  case REG_STAT:
+    return stat;
+  case REG_DMDO:
+    return dmAttrSelect ? attrs[dmAddr] : chars[dmAddr];
+  case REG_CMDO:
+    return shadow[cmal % MAX7456_CHAR_SIZE];
+  }
+  return 0;
+}
+
+void MAX7456::writeReg(uint8_t reg, uint8_t data)
+{
+  stats.regWrites++;
+  switch (reg) {
+  case REG_VM0:
+    vm0 = data;
+    if (data & VM0_RESET) {
+      memset(chars, 0, sizeof(chars));
+      memset(attrs, 0, sizeof(attrs));
+      dmm = 0;
+      dmAddr = 0;
+      dmAttrSelect = false;
+      autoInc = false;
+      vm0 &= ~VM0_RESET;
+    }
+    break;
+  case REG_DMM:
+    dmm = data;
+    if (data & DMM_CLEAR) {
+      memset(chars, 0, sizeof(chars));
+      memset(attrs, 0, sizeof(attrs));
+      dmm &= ~DMM_CLEAR;
+    }
+    autoInc = data & DMM_AUTOINC;
+    break;
+  case REG_DMAH:
+    dmAddr = (dmAddr & 0xff) | ((data & 1) << 8);
+    dmAttrSelect = data & 2;
+    break;
+  case REG_DMAL:
+    dmAddr = (dmAddr & 0x100) | data;
+    break;
+  case REG_DMDI:
+    if (dmAttrSelect)
+      attrs[dmAddr] = data;
+    else {
+      chars[dmAddr] = data;
+      attrs[dmAddr] = dmm & DMM_ATTR;
+      stats.charWrites++;
+    }
+    break;
+  case REG_CMAH:
+    cmah = data;
+    break;
+  case REG_CMAL:
+    cmal = data;
+    break;
+  case REG_CMDI:
+    shadow[cmal % MAX7456_CHAR_SIZE] = data;
+    break;
+  case REG_CMM:
+    if (data == CMM_WRITE) {
+      memcpy(nvm[cmah], shadow, MAX7456_CHAR_SIZE);
+      stats.nvmWrites++;
+    }
+    else if (data == CMM_READ)
+      memcpy(shadow, nvm[cmah], MAX7456_CHAR_SIZE);
+    break;
+  }
+}
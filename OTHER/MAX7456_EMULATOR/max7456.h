@@ -0,0 +1,52 @@
+// Software model of the MAX7456 SPI interface for host side testing.
+// Only the features used by MWOSD are modelled.
+
+#ifndef MAX7456_EMULATOR_H
+#define MAX7456_EMULATOR_H
+
+#include <stdint.h>
+
+#define MAX7456_DM_SIZE   512   // Display memory locations. 480 used in PAL
+#define MAX7456_CHARS     256
+#define MAX7456_CHAR_SIZE  64   // NVM bytes per char. 54 used
+
+struct MAX7456Stats {
+  uint32_t spiBytes;            // All bytes clocked while CS low
+  uint32_t regWrites;           // Address/data register writes
+  uint32_t autoIncBytes;        // Data only bytes written in auto increment mode
+  uint32_t charWrites;          // Display memory locations written
+  uint32_t nvmWrites;           // Chars written to NVM
+};
+
+class MAX7456 {
+public:
+  MAX7456();
+
+  void select(bool low);        // CS pin
+  uint8_t transfer(uint8_t data);
+  void clearStats(void);
+
+  uint8_t vm0;
+  uint8_t dmm;
+  uint8_t stat;                 // Returned on STAT reads. Bit 0 PAL, bit 1 NTSC
+  uint8_t chars[MAX7456_DM_SIZE];
+  uint8_t attrs[MAX7456_DM_SIZE]; // DMM style attribute bits 3..5
+  uint8_t nvm[MAX7456_CHARS][MAX7456_CHAR_SIZE];
+  MAX7456Stats stats;
+
+private:
+  void writeReg(uint8_t reg, uint8_t data);
+  uint8_t readReg(uint8_t reg);
+
+  bool cs;
+  bool autoInc;                 // 8 bit auto increment data mode active
+  int16_t pendingReg;           // Register awaiting its data byte. -1 = none
+  uint8_t readData;             // Returned on next transfer after a read command
+  uint16_t dmAddr;
+  bool dmAttrSelect;            // DMAH bit 1. Write attribute bytes
+  uint8_t cmah;
+  uint8_t cmal;
+  uint8_t shadow[MAX7456_CHAR_SIZE];
+};
+
+#endif